@@ -19,6 +19,16 @@
 		- m_iterators are convertible to iterators, but not vice versa
 		- oi_multimap uses m_iterators for lower_bound(), upper_bound() and equal_range(), iterators that follows the insertion order cannot work properly with these functions
 		- emplace_hint is just there for compatibility, it won't speed up the insertions
+		- range_in_insertion_order(a, b) returns a single pass range, invalidated by any change to the map
+		- sort_order(), stable_partition_order(), reverse_order() and move_to_front() keep every iterator valid
+		- oi_incremental_unordered_map's m_iterators are forward only and it has no bucket interface (begin(n), bucket_size()...)
+		- with secondary indexes the elements are read only, modify() is the only way to change them
+		- oi_int_map and oi_int_unordered_map invalidate their m_iterators on any insertion or erasure
+		- compact() invalidates every iterator
+		- oi_cow::snapshot() and write() belong to a single writer thread, the first write() after a snapshot copies the whole map
+		- oi_tracked only sees changes made through its own members, writes made through iterators need touch()
+		- oi_small_map invalidates every iterator when it spills
+		- frozen_oi_map requires C++14 and hashes integral, enum and (C++17) std::string_view keys, specialize frozen_hash for other literal types
 
 */
 
@@ -28,11 +38,39 @@
 #include <unordered_map>
 #include <list>
 #include <initializer_list>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if __cplusplus >= 201402L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201402L)
+	#define __NEO_OI_MAP_CPP14__
+#endif
+
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+	#include <string_view>
+#endif
 
 
 
 namespace neo {
 
+	template<class Key, class Value, std::size_t N, class Predicate, class Allocator> class oi_small_map;
+
 	namespace __oi_map_details {
 
 		// Inheritance order : oi_base -> oi_single/oi_multi -> oi_ordered/oi_unordered
@@ -103,96 +141,216 @@ namespace neo {
 
 		};
 
-		template<class ValType> class iter;
-		template<class ValType> class const_iter;
-		template<class ValType, template<class...> class STL> class m_iter;
-		template<class ValType, template<class...> class STL> class m_const_iter;
-		template<class ValType, template<class...> class STL> class local_iter;
-		template<class ValType, template<class...> class STL> class const_local_iter;
+		template<class IndexOf, class Node, bool = IndexOf::stable>
+		struct index_handle {
+			typename IndexOf::template map<Node>::iterator index;
+		};
+		template<class IndexOf, class Node>
+		struct index_handle<IndexOf, Node, false> {};
+
+		template<class ValType, class IndexOf, class Node>
+		struct oi_node_base : index_handle<IndexOf, Node> {
+
+			using value_type	= ValType;
+			using access_type	= ValType;
+			using index_of		= IndexOf;
+
+			template<class... Args>
+			oi_node_base(std::uint64_t number, Args&&... args) : value(std::forward<Args>(args)...), seq(number) {}
+
+			ValType			value;
+			std::uint64_t	seq;
+
+		};
+
+		template<class ValType, class IndexOf>
+		struct oi_node : oi_node_base<ValType, IndexOf, oi_node<ValType, IndexOf>> {
+			using oi_node_base<ValType, IndexOf, oi_node>::oi_node_base;
+		};
+
+		template<class ValType, class IndexOf, class... Indexes>
+		struct oi_indexed_node : oi_node_base<ValType, IndexOf, oi_indexed_node<ValType, IndexOf, Indexes...>> {
+
+			using access_type = const ValType;
+
+			using oi_node_base<ValType, IndexOf, oi_indexed_node>::oi_node_base;
+
+			std::tuple<typename Indexes::template hook<oi_indexed_node>...>	hooks;
+			typename std::list<oi_indexed_node>::iterator					self;
+
+		};
+
+		template<class Node> class iter;
+		template<class Node> class const_iter;
+		template<class Node, class Map> class m_iter;
+		template<class Node, class Map> class m_const_iter;
+		template<class Node, class Map> class local_iter;
+		template<class Node, class Map> class const_local_iter;
+		template<class Node, class MapIterator, class ListIter> class group_iter;
 
-		template<class ValType> class iter : public std::list<ValType>::iterator {
+		template<class Node> class iter : public std::list<Node>::iterator {
+			private:
+				using list_iter = typename std::list<Node>::iterator;
 			public:
-				using std::list<ValType>::iterator::iterator;
-				using std::list<ValType>::iterator::operator=;
+				using iterator_category = std::bidirectional_iterator_tag;
+				using value_type		= typename Node::value_type;
+				using difference_type	= std::ptrdiff_t;
+				using pointer			= typename Node::access_type*;
+				using reference			= typename Node::access_type&;
+
+				using list_iter::list_iter;
+				using list_iter::operator=;
 				iter() {}
-				template<template<class...> class STL> iter(const m_iter<ValType, STL>& other) : std::list<ValType>::iterator(other._iter->second) {}
-				template<template<class...> class STL> iter(m_iter<ValType, STL>&& other) : std::list<ValType>::iterator(std::forward<m_iter<ValType, STL>>(other)._iter->second) {}
-				template<template<class...> class STL> iter& operator=(const m_iter<ValType, STL>& other) {
+				template<class Map> iter(const m_iter<Node, Map>& other) : list_iter(other._iter->second) {}
+				template<class Map> iter(m_iter<Node, Map>&& other) : list_iter(std::forward<m_iter<Node, Map>>(other)._iter->second) {}
+				template<class Map> iter& operator=(const m_iter<Node, Map>& other) {
 					*this = other._iter->second;
 					return *this;
 				}
-				template<template<class...> class STL> iter& operator=(m_iter<ValType, STL>&& other) {
-					*this = std::forward<m_iter<ValType, STL>>(other)._iter->second;
+				template<class Map> iter& operator=(m_iter<Node, Map>&& other) {
+					*this = std::forward<m_iter<Node, Map>>(other)._iter->second;
+					return *this;
+				}
+
+				template<class MapIterator> iter(const group_iter<Node, MapIterator, iter>& other) : list_iter(other._iter->second[other._idx]) {}
+
+				iter(const list_iter& other) : list_iter(other) {}
+				iter(list_iter&& other) : list_iter(std::forward<list_iter>(other)) {}
+
+				iter& operator++() {
+					list_iter::operator++();
+					return *this;
+				}
+				iter operator++(int) {
+					iter tmp(*this);
+					list_iter::operator++();
+					return tmp;
+				}
+				iter& operator--() {
+					list_iter::operator--();
 					return *this;
 				}
+				iter operator--(int) {
+					iter tmp(*this);
+					list_iter::operator--();
+					return tmp;
+				}
 
-				iter(const typename std::list<ValType>::iterator& other) : std::list<ValType>::iterator(other) {}
-				iter(typename std::list<ValType>::iterator&& other) : std::list<ValType>::iterator(std::forward<typename std::list<ValType>::iterator>(other)) {}
+				reference operator*() const {
+					return list_iter::operator*().value;
+				}
+				pointer operator->() const {
+					return &list_iter::operator*().value;
+				}
+
+				std::uint64_t seq() const {
+					return list_iter::operator*().seq;
+				}
 		};
-		template<class ValType> class const_iter : public std::list<ValType>::const_iterator {
+		template<class Node> class const_iter : public std::list<Node>::const_iterator {
+			private:
+				using list_iter = typename std::list<Node>::const_iterator;
 			public:
-				using std::list<ValType>::const_iterator::const_iterator;
-				using std::list<ValType>::const_iterator::operator=;
+				using iterator_category = std::bidirectional_iterator_tag;
+				using value_type		= typename Node::value_type;
+				using difference_type	= std::ptrdiff_t;
+				using pointer			= const value_type*;
+				using reference			= const value_type&;
+
+				using list_iter::list_iter;
+				using list_iter::operator=;
 				const_iter() {}
 
-				const_iter(const iter<ValType>& other) : std::list<ValType>::const_iterator(other) {}
-				const_iter(iter<ValType>&& other) : std::list<ValType>::const_iterator(std::forward<iter<ValType>>(other)) {}
-				const_iter& operator=(const iter<ValType>& other) {
+				const_iter(const iter<Node>& other) : list_iter(other) {}
+				const_iter(iter<Node>&& other) : list_iter(std::forward<iter<Node>>(other)) {}
+				const_iter& operator=(const iter<Node>& other) {
 					*this = static_cast<const const_iter&>(other);
 					return *this;
 				}
-				const_iter& operator=(iter<ValType>&& other) {
-					*this = static_cast<const_iter&&>(std::forward<iter<ValType>>(other));
+				const_iter& operator=(iter<Node>&& other) {
+					*this = static_cast<const_iter&&>(std::forward<iter<Node>>(other));
 					return *this;
 				}
 
-				template<template<class...> class STL>const_iter(const m_iter<ValType, STL>& other) : std::list<ValType>::const_iterator(other._iter->second) {}
-				template<template<class...> class STL>const_iter(m_iter<ValType, STL>&& other) : std::list<ValType>::const_iterator(std::forward<m_iter<ValType, STL>>(other)._iter->second) {}
-				template<template<class...> class STL>const_iter& operator=(const m_iter<ValType, STL>& other) {
+				template<class Map> const_iter(const m_iter<Node, Map>& other) : list_iter(other._iter->second) {}
+				template<class Map> const_iter(m_iter<Node, Map>&& other) : list_iter(std::forward<m_iter<Node, Map>>(other)._iter->second) {}
+				template<class Map> const_iter& operator=(const m_iter<Node, Map>& other) {
 					*this = static_cast<const const_iter&>(other);
 					return *this;
 				}
-				template<template<class...> class STL>const_iter& operator=(m_iter<ValType, STL>&& other) {
-					*this = static_cast<const_iter&&>(std::forward<m_iter<ValType, STL>>(other));
+				template<class Map> const_iter& operator=(m_iter<Node, Map>&& other) {
+					*this = static_cast<const_iter&&>(std::forward<m_iter<Node, Map>>(other));
 					return *this;
 				}
 
-				template<template<class...> class STL>const_iter(const m_const_iter<ValType, STL>& other) : std::list<ValType>::const_iterator(other._iter->second) {}
-				template<template<class...> class STL>const_iter(m_const_iter<ValType, STL>&& other) : std::list<ValType>::const_iterator(std::forward<m_const_iter<ValType, STL>>(other)._iter->second) {}
-				template<template<class...> class STL>const_iter& operator=(const m_const_iter<ValType, STL>& other) {
+				template<class Map> const_iter(const m_const_iter<Node, Map>& other) : list_iter(other._iter->second) {}
+				template<class Map> const_iter(m_const_iter<Node, Map>&& other) : list_iter(std::forward<m_const_iter<Node, Map>>(other)._iter->second) {}
+				template<class Map> const_iter& operator=(const m_const_iter<Node, Map>& other) {
 					*this = static_cast<const const_iter&>(other);
 					return *this;
 				}
-				template<template<class...> class STL>const_iter& operator=(m_const_iter<ValType, STL>&& other) {
-					*this = static_cast<const_iter&&>(std::forward<m_const_iter<ValType, STL>>(other));
+				template<class Map> const_iter& operator=(m_const_iter<Node, Map>&& other) {
+					*this = static_cast<const_iter&&>(std::forward<m_const_iter<Node, Map>>(other));
+					return *this;
+				}
+
+				template<class MapIterator, class ListIter> const_iter(const group_iter<Node, MapIterator, ListIter>& other) : list_iter(other._iter->second[other._idx]) {}
+
+				const_iter(const list_iter& other) : list_iter(other) {}
+				const_iter(list_iter&& other) : list_iter(other) {}
+
+				const_iter& operator++() {
+					list_iter::operator++();
+					return *this;
+				}
+				const_iter operator++(int) {
+					const_iter tmp(*this);
+					list_iter::operator++();
+					return tmp;
+				}
+				const_iter& operator--() {
+					list_iter::operator--();
 					return *this;
 				}
+				const_iter operator--(int) {
+					const_iter tmp(*this);
+					list_iter::operator--();
+					return tmp;
+				}
 
-				const_iter(const typename std::list<ValType>::const_iterator& other) : std::list<ValType>::const_iterator(other) {}
-				const_iter(typename std::list<ValType>::const_iterator&& other) : std::list<ValType>::const_iterator(other) {}
+				reference operator*() const {
+					return list_iter::operator*().value;
+				}
+				pointer operator->() const {
+					return &list_iter::operator*().value;
+				}
+
+				std::uint64_t seq() const {
+					return list_iter::operator*().seq;
+				}
 		};
-		template<class ValType, template<class...> class STL> class m_iter : public oi_iterator<typename STL<typename ValType::first_type, typename std::list<ValType>::iterator>::iterator, typename std::list<ValType>::iterator, m_iter<ValType, STL>> {
+		template<class Node, class Map> class m_iter : public oi_iterator<typename Map::iterator, iter<Node>, m_iter<Node, Map>> {
 			private:
-				using oi_iter_base = oi_iterator<typename STL<typename ValType::first_type, typename std::list<ValType>::iterator>::iterator, typename std::list<ValType>::iterator, m_iter<ValType, STL>>;
+				using oi_iter_base = oi_iterator<typename Map::iterator, iter<Node>, m_iter<Node, Map>>;
 			public:
 				using oi_iter_base::oi_iter_base;
 				using oi_iter_base::operator==;
 				using oi_iter_base::operator!=;
 
-				bool operator==(const m_const_iter<ValType, STL>& other) const {
-					return static_cast<const m_const_iter<ValType, STL>&>(*this) == other;
+				bool operator==(const m_const_iter<Node, Map>& other) const {
+					return static_cast<const m_const_iter<Node, Map>&>(*this) == other;
 				}
-				bool operator!=(const m_const_iter<ValType, STL>& other) const {
+				bool operator!=(const m_const_iter<Node, Map>& other) const {
 					return !(*this == other);
 				}
 
-				friend iter<ValType>;
-				friend const_iter<ValType>;
-				friend m_const_iter<ValType, STL>;
+				friend iter<Node>;
+				friend const_iter<Node>;
+				friend m_const_iter<Node, Map>;
 		};
-		template<class ValType, template<class...> class STL> class m_const_iter : public oi_iterator<typename STL<typename ValType::first_type, typename std::list<ValType>::iterator>::const_iterator, typename std::list<ValType>::const_iterator, m_const_iter<ValType, STL>> {
+		template<class Node, class Map> class m_const_iter : public oi_iterator<typename Map::const_iterator, const_iter<Node>, m_const_iter<Node, Map>> {
 			private:
-				using oi_iter_base = oi_iterator<typename STL<typename ValType::first_type, typename std::list<ValType>::iterator>::const_iterator, typename std::list<ValType>::const_iterator, m_const_iter<ValType, STL>>;
+				using oi_iter_base = oi_iterator<typename Map::const_iterator, const_iter<Node>, m_const_iter<Node, Map>>;
 			public:
 				using oi_iter_base::oi_iter_base;
 				using oi_iter_base::operator=;
@@ -200,50 +358,50 @@ namespace neo {
 				using oi_iter_base::operator!=;
 
 				m_const_iter() {}
-				m_const_iter(const m_iter<ValType, STL>& other) {
+				m_const_iter(const m_iter<Node, Map>& other) {
 					this->_iter = other._iter;
 				}
-				m_const_iter(m_iter<ValType, STL>&& other) {
-					this->_iter = std::forward<m_iter<ValType, STL>>(other)._iter;
+				m_const_iter(m_iter<Node, Map>&& other) {
+					this->_iter = std::forward<m_iter<Node, Map>>(other)._iter;
 				}
-				m_const_iter& operator=(const m_iter<ValType, STL>& other) {
+				m_const_iter& operator=(const m_iter<Node, Map>& other) {
 					*this = static_cast<const m_const_iter&>(other);
 					return *this;
 				}
-				m_const_iter& operator=(m_iter<ValType, STL>&& other) {
-					*this = static_cast<m_const_iter&&>(std::forward<m_iter<ValType, STL>>(other));
+				m_const_iter& operator=(m_iter<Node, Map>&& other) {
+					*this = static_cast<m_const_iter&&>(std::forward<m_iter<Node, Map>>(other));
 					return *this;
 				}
 
-				bool operator==(const m_iter<ValType, STL>& other) const {
+				bool operator==(const m_iter<Node, Map>& other) const {
 					return *this == static_cast<const m_const_iter&>(other);
 				}
-				bool operator!=(const m_iter<ValType, STL>& other) const {
+				bool operator!=(const m_iter<Node, Map>& other) const {
 					return !(*this == other);
 				}
 
-				friend const_iter<ValType>;
+				friend const_iter<Node>;
 		};
-		template<class ValType, template<class...> class STL> class local_iter : public oi_iterator<typename STL<typename ValType::first_type, typename std::list<ValType>::iterator>::local_iterator, typename std::list<ValType>::iterator, local_iter<ValType, STL>> {
+		template<class Node, class Map> class local_iter : public oi_iterator<typename Map::local_iterator, iter<Node>, local_iter<Node, Map>> {
 			private:
-				using oi_iter_base = oi_iterator<typename STL<typename ValType::first_type, typename std::list<ValType>::iterator>::local_iterator, typename std::list<ValType>::iterator, local_iter<ValType, STL>>;
+				using oi_iter_base = oi_iterator<typename Map::local_iterator, iter<Node>, local_iter<Node, Map>>;
 			public:
 				using oi_iter_base::oi_iter_base;
 				using oi_iter_base::operator==;
 				using oi_iter_base::operator!=;
 
-				bool operator==(const const_local_iter<ValType, STL>& other) const {
-					return static_cast<const const_local_iter<ValType, STL>&>(*this) == other;
+				bool operator==(const const_local_iter<Node, Map>& other) const {
+					return static_cast<const const_local_iter<Node, Map>&>(*this) == other;
 				}
-				bool operator!=(const const_local_iter<ValType, STL>& other) const {
+				bool operator!=(const const_local_iter<Node, Map>& other) const {
 					return !(*this == other);
 				}
 
-				friend const_local_iter<ValType, STL>;
+				friend const_local_iter<Node, Map>;
 		};
-		template<class ValType, template<class...> class STL> class const_local_iter : public oi_iterator<typename STL<typename ValType::first_type, typename std::list<ValType>::iterator>::const_local_iterator, typename std::list<ValType>::const_iterator, const_local_iter<ValType, STL>> {
+		template<class Node, class Map> class const_local_iter : public oi_iterator<typename Map::const_local_iterator, const_iter<Node>, const_local_iter<Node, Map>> {
 			private:
-				using oi_iter_base = oi_iterator<typename STL<typename ValType::first_type, typename std::list<ValType>::iterator>::const_local_iterator, typename std::list<ValType>::const_iterator, const_local_iter<ValType, STL>>;
+				using oi_iter_base = oi_iterator<typename Map::const_local_iterator, const_iter<Node>, const_local_iter<Node, Map>>;
 			public:
 				using oi_iter_base::oi_iter_base;
 				using oi_iter_base::operator=;
@@ -251,687 +409,4677 @@ namespace neo {
 				using oi_iter_base::operator!=;
 
 				const_local_iter() {}
-				const_local_iter(const local_iter<ValType, STL>& other) {
+				const_local_iter(const local_iter<Node, Map>& other) {
 					this->_iter = other._iter;
 				}
-				const_local_iter(local_iter<ValType, STL>&& other) {
-					this->_iter = std::forward<local_iter<ValType, STL>>(other)._iter;
+				const_local_iter(local_iter<Node, Map>&& other) {
+					this->_iter = std::forward<local_iter<Node, Map>>(other)._iter;
 				}
-				const_local_iter& operator=(const local_iter<ValType, STL>& other) {
+				const_local_iter& operator=(const local_iter<Node, Map>& other) {
 					*this = static_cast<const const_local_iter&>(other);
 					return *this;
 				}
-				const_local_iter& operator=(local_iter<ValType, STL>&& other) {
-					*this = static_cast<const_local_iter&&>(std::forward<local_iter<ValType, STL>>(other));
+				const_local_iter& operator=(local_iter<Node, Map>&& other) {
+					*this = static_cast<const_local_iter&&>(std::forward<local_iter<Node, Map>>(other));
 					return *this;
 				}
 
-				bool operator==(const local_iter<ValType, STL>& other) const {
+				bool operator==(const local_iter<Node, Map>& other) const {
 					return *this == static_cast<const const_local_iter&>(other);
 				}
-				bool operator!=(const local_iter<ValType, STL>& other) const {
+				bool operator!=(const local_iter<Node, Map>& other) const {
 					return !(*this == other);
 				}
 		};
+		template<class Node, class MapIterator, class ListIter> class group_iter { // m_iterator of a grouped index: walks the keys and, within each key, its elements in insertion order
 
-		template<class Key, class Value, class Allocator, class Map, template<class...> class STL>
-		class oi_base {
-
-			protected:
-
-				using _list_t = std::list<std::pair<const Key, Value>>;
-				using _map_t  = Map;
+			public:
 
-				_list_t _list;
-				_map_t	_map;
+				using iterator_category = typename std::iterator_traits<MapIterator>::iterator_category;
+				using value_type		= typename ListIter::value_type;
+				using difference_type	= std::ptrdiff_t;
+				using pointer			= typename ListIter::pointer;
+				using reference			= typename ListIter::reference;
 
-			public:
+				group_iter() : _idx(0) {}
+				group_iter(const MapIterator& iter, std::size_t idx = 0) : _iter(iter), _idx(idx) {}
+				template<class OtherIterator, class OtherList, class = typename std::enable_if<std::is_convertible<OtherIterator, MapIterator>::value>::type>
+				group_iter(const group_iter<Node, OtherIterator, OtherList>& other) : _iter(other._iter), _idx(other._idx) {}
 
-				// Member Types:
+				friend bool operator==(const group_iter& left, const group_iter& right) {
+					return left._iter == right._iter && left._idx == right._idx;
+				}
+				friend bool operator!=(const group_iter& left, const group_iter& right) {
+					return !(left == right);
+				}
 
-				using key_type					= Key;
-				using mapped_type				= Value;
-				using value_type				= std::pair<const key_type, mapped_type>;
-				using size_type					= typename _map_t::size_type;
-				using difference_type			= typename _map_t::difference_type;
+				group_iter& operator++() {
+					if(++_idx == _iter->second.size()) {
+						++_iter;
+						_idx = 0;
+					}
+					return *this;
+				}
+				group_iter operator++(int) {
+					group_iter tmp(*this);
+					++(*this);
+					return tmp;
+				}
 
-				using allocator_type			= Allocator;
+				group_iter& operator--() {
+					if(_idx == 0) {
+						--_iter;
+						_idx = _iter->second.size();
+					}
+					--_idx;
+					return *this;
+				}
+				group_iter operator--(int) {
+					group_iter tmp(*this);
+					--(*this);
+					return tmp;
+				}
 
-				using pointer					= typename Allocator::pointer;
-				using const_pointer				= typename Allocator::const_pointer;
-				using reference					= typename Allocator::reference;
-				using const_reference			= typename Allocator::const_reference;
+				reference operator*() const {
+					return *_iter->second[_idx];
+				}
+				pointer operator->() const {
+					return &*_iter->second[_idx];
+				}
 
-				using iterator					= iter<value_type>;
-				using const_iterator			= const_iter<value_type>;
+			private:
 
-				using m_iterator				= m_iter<value_type, STL>;
-				using m_const_iterator			= m_const_iter<value_type, STL>;
-				using m_reverse_iterator		= std::reverse_iterator<m_iterator>;
-				using m_const_reverse_iterator	= std::reverse_iterator<m_const_iterator>;
+				MapIterator	_iter;
+				std::size_t	_idx; // position within the group of _iter, always 0 at the end of the index
 
-				// Constructors:
+				template<class, class, class> friend class group_iter;
+				friend iter<Node>;
+				friend const_iter<Node>;
 
-				oi_base() {}
-				explicit oi_base(const allocator_type& alloc) : _list(alloc) {}
+		};
 
-				oi_base(const oi_base&) = default;
-				oi_base(const oi_base& other, const allocator_type& alloc) : _list(alloc) {
-				    *this = other;
-                }
+		template<class ValType, class IndexOf, class... Indexes>
+		struct node_with {
+			using type = oi_indexed_node<ValType, IndexOf, Indexes...>;
+		};
+		template<class ValType, class IndexOf>
+		struct node_with<ValType, IndexOf> {
+			using type = oi_node<ValType, IndexOf>;
+		};
 
-				oi_base(oi_base&&) = default;
-				oi_base(oi_base&& other, const allocator_type& alloc) : _list(alloc) {
-                    *this = std::forward<oi_base>(other);
-				}
+		template<class T>
+		class index_group { // elements of a key in a grouped index, sorted by seq, the front is popped in O(1) by moving a head offset
 
-				oi_base& operator=(const oi_base&) = default;
-				oi_base& operator=(oi_base&&) = default;
+			public:
 
-				// Iterators:
+				using iterator			= typename std::vector<T>::iterator;
+				using const_iterator	= typename std::vector<T>::const_iterator;
 
 				iterator begin() noexcept {
-					return _list.begin();
+					return _items.begin() + _head;
 				}
 				const_iterator begin() const noexcept {
-					return _list.begin();
-				}
-				const_iterator cbegin() const noexcept {
-					return _list.cbegin();
+					return _items.begin() + _head;
 				}
 				iterator end() noexcept {
-					return _list.end();
+					return _items.end();
 				}
 				const_iterator end() const noexcept {
-					return _list.end();
+					return _items.end();
 				}
-				const_iterator cend() const noexcept {
-					return _list.cend();
+
+				bool empty() const noexcept {
+					return _head == _items.size();
+				}
+				std::size_t size() const noexcept {
+					return _items.size() - _head;
 				}
 
-				m_iterator m_begin() noexcept {
-					return _map.begin();
+				T& operator[](std::size_t n) {
+					return _items[_head + n];
 				}
-				m_const_iterator m_begin() const noexcept {
-					return _map.begin();
+				const T& operator[](std::size_t n) const {
+					return _items[_head + n];
 				}
-				m_const_iterator m_cbegin() const noexcept {
-					return _map.cbegin();
+				const T& front() const {
+					return _items[_head];
 				}
-				m_iterator m_end() noexcept {
-					return _map.end();
+				const T& back() const {
+					return _items.back();
 				}
-				m_const_iterator m_end() const noexcept {
-					return _map.end();
+				const T* data() const noexcept {
+					return _items.data() + _head;
 				}
-				m_const_iterator m_cend() const noexcept {
-					return _map.cend();
+
+				void push_back(const T& val) {
+					_items.push_back(val);
+				}
+				iterator insert(const_iterator pos, const T& val) {
+					return _items.insert(pos, val);
+				}
+				void erase(const_iterator pos) {
+					if(pos != begin()) {
+						_items.erase(pos);
+					}
+					else if(++_head * 2 >= _items.size()) { // drops the dead prefix once it's half of the storage, amortized O(1)
+						_items.erase(_items.begin(), _items.begin() + _head);
+						_head = 0;
+					}
 				}
 
-				m_reverse_iterator m_rbegin() noexcept {
-					return _map.rbegin();
+			private:
+
+				std::vector<T>	_items;
+				std::size_t		_head = 0;
+
+		};
+
+		template<class Node, bool Grouped>
+		struct index_mapped {
+			using type = iter<Node>;
+		};
+		template<class Node>
+		struct index_mapped<Node, true> {
+			using type = index_group<iter<Node>>;
+		};
+
+		template<std::size_t... Is> struct index_seq {};
+		template<std::size_t N, std::size_t... Is> struct make_index_seq : make_index_seq<N - 1, N - 1, Is...> {};
+		template<std::size_t... Is> struct make_index_seq<0, Is...> {
+			using type = index_seq<Is...>;
+		};
+
+		template<class Mapped> struct index_node_of;
+		template<class Node> struct index_node_of<iter<Node>> {
+			using type = Node;
+		};
+		template<class Node> struct index_node_of<index_group<iter<Node>>> {
+			using type = Node;
+		};
+
+		template<class Node, class Map, bool Grouped = std::is_same<typename Map::mapped_type, index_group<iter<Node>>>::value>
+		struct index_types {
+			static constexpr bool grouped = false;
+			using m_iterator			= m_iter<Node, Map>;
+			using m_const_iterator		= m_const_iter<Node, Map>;
+			template<class M> using local_iterator			= local_iter<Node, M>; // templates so indexes without buckets never name M::local_iterator
+			template<class M> using const_local_iterator	= const_local_iter<Node, M>;
+		};
+		template<class Node, class Map>
+		struct index_types<Node, Map, true> {
+			static constexpr bool grouped = true;
+			using m_iterator			= group_iter<Node, typename Map::iterator, iter<Node>>;
+			using m_const_iterator		= group_iter<Node, typename Map::const_iterator, const_iter<Node>>;
+			template<class M> using local_iterator			= group_iter<Node, typename M::local_iterator, iter<Node>>;
+			template<class M> using const_local_iterator	= group_iter<Node, typename M::const_local_iterator, const_iter<Node>>;
+		};
+
+		template<class Map>
+		Map index_like(const Map& other, std::size_t) { // empty index with the same predicate
+			return Map(other.key_comp());
+		}
+		template<class... Args>
+		std::unordered_map<Args...> index_like(const std::unordered_map<Args...>& other, std::size_t n) { // and with its buckets sized for n elements
+			std::unordered_map<Args...> map(0, other.hash_function(), other.key_eq());
+			map.max_load_factor(other.max_load_factor());
+			map.reserve(n);
+			return map;
+		}
+
+		struct index_hash {
+			template<class T>
+			std::size_t operator()(const T& val) const {
+				return std::hash<T>()(val);
+			}
+		};
+		struct index_equal_to {
+			template<class T>
+			bool operator()(const T& left, const T& right) const {
+				return left == right;
+			}
+		};
+		struct index_less {
+			template<class T>
+			bool operator()(const T& left, const T& right) const {
+				return left < right;
+			}
+		};
+
+		template<class Node, class Ref, class Index>
+		class secondary_iter {
+
+			public:
+
+				using iterator_category = typename Index::iterator_category;
+				using value_type		= typename Node::value_type;
+				using difference_type	= std::ptrdiff_t;
+				using pointer			= const value_type*;
+				using reference			= const value_type&;
+
+				secondary_iter() : _node(nullptr), _index(nullptr) {}
+				secondary_iter(Node* node, const Index* index) : _node(node), _index(index) {}
+				template<class OtherRef, class = typename std::enable_if<std::is_convertible<OtherRef*, Ref*>::value>::type>
+				secondary_iter(const secondary_iter<Node, OtherRef, Index>& other) : _node(other._node), _index(other._index) {}
+
+				friend bool operator==(const secondary_iter& left, const secondary_iter& right) {
+					return left._node == right._node;
 				}
-				m_const_reverse_iterator m_rbegin() const noexcept {
-					return _map.rbegin();
+				friend bool operator!=(const secondary_iter& left, const secondary_iter& right) {
+					return left._node != right._node;
 				}
-				m_const_reverse_iterator m_crbegin() const noexcept {
-					return _map.crbegin();
+
+				secondary_iter& operator++() {
+					_node = _index->_next(_node);
+					return *this;
 				}
-				m_reverse_iterator m_rend() noexcept {
-					return _map.rend();
+				secondary_iter operator++(int) {
+					secondary_iter tmp(*this);
+					++(*this);
+					return tmp;
 				}
-				m_const_reverse_iterator m_rend() const noexcept {
-					return _map.rend();
+				secondary_iter& operator--() {
+					_node = _index->_prev(_node);
+					return *this;
 				}
-				m_const_reverse_iterator m_crend() const noexcept {
-					return _map.crend();
+				secondary_iter operator--(int) {
+					secondary_iter tmp(*this);
+					--(*this);
+					return tmp;
 				}
 
-				// Capacity:
-
-				bool empty() const noexcept {
-					return _map.empty();
+				reference operator*() const {
+					return _node->value;
 				}
-				size_type size() const noexcept {
-					return _map.size();
+				pointer operator->() const {
+					return &_node->value;
 				}
-				size_type max_size() const noexcept {
-					return _map.max_size();
+
+				operator const_iter<Node>() const {
+					return const_iter<Node>(iter<Node>(_node->self));
+				}
+				template<class R = Ref, class = typename std::enable_if<!std::is_const<R>::value>::type>
+				operator iter<Node>() const {
+					return iter<Node>(_node->self);
 				}
 
-				// Modifiers:
+			private:
 
-				void swap(oi_base& other) {
-					_list.swap(other._list);
-					_map.swap(other._map);
+				Node*			_node;
+				const Index*	_index;
+
+				template<class, class, class> friend class secondary_iter;
+
+		};
+
+		template<class Node>
+		struct hashed_hook {
+			Node*		prev;
+			Node*		next;
+			std::size_t	hash;
+		};
+
+		template<class Node, std::size_t I, class KeyFn, class Hash, class Pred>
+		class hashed_index { // intrusive chained hash table, equal keys stay next to each other
+
+			public:
+
+				using key_type			= typename std::decay<decltype(std::declval<const KeyFn&>()(std::declval<const typename Node::value_type::second_type&>()))>::type;
+				using value_type		= typename Node::value_type;
+				using size_type			= std::size_t;
+				using iterator_category	= std::forward_iterator_tag;
+				using iterator			= secondary_iter<Node, value_type, hashed_index>;
+				using const_iterator	= secondary_iter<Node, const value_type, hashed_index>;
+
+				hashed_index() : _size(0), _shift(64) {}
+				hashed_index(hashed_index&& other) noexcept : hashed_index() {
+					*this = std::move(other);
+				}
+				hashed_index& operator=(hashed_index&& other) noexcept {
+					_buckets = std::move(other._buckets);
+					_size = other._size;
+					_shift = other._shift;
+					other._buckets.clear();
+					other._size = 0;
+					other._shift = 64;
+					return *this;
 				}
 
-				void clear() noexcept {
-					_list.clear();
-					_map.clear();
+				iterator end() noexcept {
+					return iterator(nullptr, this);
+				}
+				const_iterator end() const noexcept {
+					return const_iterator(nullptr, this);
 				}
 
-				// Operations:
+				bool empty() const noexcept {
+					return _size == 0;
+				}
+				size_type size() const noexcept {
+					return _size;
+				}
 
 				iterator find(const key_type& key) {
-					typename _map_t::iterator it_map = _map.find(key);
-					return it_map != _map.end() ? it_map->second : end();
+					return iterator(_find(key), this);
 				}
 				const_iterator find(const key_type& key) const {
-					typename _map_t::const_iterator it_map = _map.find(key);
-					return it_map != _map.end() ? it_map->second : end();
+					return const_iterator(_find(key), this);
 				}
-
 				size_type count(const key_type& key) const {
-					return _map.count(key);
+					std::pair<const_iterator, const_iterator> range = equal_range(key);
+					return static_cast<size_type>(std::distance(range.first, range.second));
+				}
+				std::pair<iterator, iterator> equal_range(const key_type& key) {
+					Node* first = _find(key);
+					return std::pair<iterator, iterator>(iterator(first, this), iterator(_group_end(first), this));
+				}
+				std::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+					Node* first = _find(key);
+					return std::pair<const_iterator, const_iterator>(const_iterator(first, this), const_iterator(_group_end(first), this));
 				}
 
-				// Allocator:
+			private:
 
-				allocator_type get_allocator() const noexcept {
-					return allocator_type();
-				}
+				std::vector<Node*>	_buckets;
+				size_type			_size;
+				unsigned			_shift;
+				KeyFn				_key;
+				Hash				_hasher;
+				Pred				_eq;
 
-				// Extra:
+				static hashed_hook<Node>& _hook(Node* node) {
+					return std::get<I>(node->hooks);
+				}
+				static Node* _next(Node* node) {
+					return _hook(node).next;
+				}
+				std::size_t _bucket(std::size_t hash) const {
+					return static_cast<std::size_t>((static_cast<std::uint64_t>(hash) * 0x9E3779B97F4A7C15ull) >> _shift);
+				}
+				bool _equal(Node* node, std::size_t hash, const key_type& key) const {
+					return _hook(node).hash == hash && _eq(_key(node->value.second), key);
+				}
 
-				void splice(const_iterator position, const_iterator element) {
-					_list.splice(position, _list, element);
+				Node* _find(const key_type& key) const {
+					if(_size == 0)
+						return nullptr;
+					std::size_t hash = _hasher(key);
+					Node* node = _buckets[_bucket(hash)];
+					while(node && !_equal(node, hash, key))
+						node = _hook(node).next;
+					return node;
 				}
-				void splice(const_iterator position, const_iterator left, const_iterator right) {
-					_list.splice(position, _list, left, right);
+				Node* _group_end(Node* first) const {
+					if(!first)
+						return nullptr;
+					Node* node = _hook(first).next;
+					while(node && _equal(node, _hook(first).hash, _key(first->value.second)))
+						node = _hook(node).next;
+					return node;
 				}
 
-			protected:
+				void _link(Node* node) {
+					if(_size >= _buckets.size())
+						_rehash(_buckets.empty() ? 8 : _buckets.size() * 2);
+					hashed_hook<Node>& hook = _hook(node);
+					hook.hash = _hasher(_key(node->value.second));
+					Node*& head = _buckets[_bucket(hook.hash)];
+					Node* pos = head;
+					while(pos && !_equal(pos, hook.hash, _key(node->value.second)))
+						pos = _hook(pos).next;
+					if(!pos)
+						pos = head;
+					hook.next = pos;
+					hook.prev = pos ? _hook(pos).prev : nullptr;
+					if(hook.prev)
+						_hook(hook.prev).next = node;
+					else
+						head = node;
+					if(pos)
+						_hook(pos).prev = node;
+					++_size;
+				}
+				void _unlink(Node* node) {
+					hashed_hook<Node>& hook = _hook(node);
+					if(hook.prev)
+						_hook(hook.prev).next = hook.next;
+					else
+						_buckets[_bucket(hook.hash)] = hook.next;
+					if(hook.next)
+						_hook(hook.next).prev = hook.prev;
+					--_size;
+				}
+				void _clear() {
+					std::fill(_buckets.begin(), _buckets.end(), nullptr);
+					_size = 0;
+				}
+				void _rehash(size_type count) {
+					std::vector<Node*> buckets(count), tails(count);
+					unsigned shift = 64;
+					for(size_type n = count; n > 1; n >>= 1)
+						--shift;
+					_shift = shift;
+					for(Node* node : _buckets) {
+						while(node) {
+							Node* next = _hook(node).next;
+							std::size_t b = _bucket(_hook(node).hash);
+							_hook(node).prev = tails[b];
+							_hook(node).next = nullptr;
+							(tails[b] ? _hook(tails[b]).next : buckets[b]) = node;
+							tails[b] = node;
+							node = next;
+						}
+					}
+					_buckets.swap(buckets);
+				}
 
-				template<class... Args>
-				oi_base(const allocator_type& alloc, Args&&... args) : _list(alloc), _map(args...) {}
+				template<class, class, class> friend class secondary_iter;
+				template<class, class...> friend class indexed_table;
 
 		};
 
-		template<class Key, class Value, class Allocator, class Map, template<class...> class STL>
-		class oi_single : public oi_base<Key, Value, Allocator, Map, STL> {
-
-			protected:
+		template<class Node>
+		struct ordered_hook {
+			Node*			parent;
+			Node*			left;
+			Node*			right;
+			std::uint32_t	priority;
+		};
 
-				using _list_t			= typename oi_single::_list_t;
-				using _map_t			= typename oi_single::_map_t;
+		template<class Node, std::size_t I, class KeyFn, class Compare>
+		class ordered_index { // intrusive treap, equal keys stay in insertion order
 
 			public:
 
-				// Member Types:
+				using key_type			= typename std::decay<decltype(std::declval<const KeyFn&>()(std::declval<const typename Node::value_type::second_type&>()))>::type;
+				using value_type		= typename Node::value_type;
+				using size_type			= std::size_t;
+				using iterator_category	= std::bidirectional_iterator_tag;
+				using iterator			= secondary_iter<Node, value_type, ordered_index>;
+				using const_iterator	= secondary_iter<Node, const value_type, ordered_index>;
 
-				using key_type			= typename oi_single::key_type;
-				using mapped_type		= typename oi_single::mapped_type;
-				using value_type		= typename oi_single::value_type;
-				using size_type			= typename oi_single::size_type;
+				ordered_index() : _root(nullptr), _size(0), _random(2463534242u) {}
+				ordered_index(ordered_index&& other) noexcept : ordered_index() {
+					*this = std::move(other);
+				}
+				ordered_index& operator=(ordered_index&& other) noexcept {
+					_root = other._root;
+					_size = other._size;
+					other._root = nullptr;
+					other._size = 0;
+					return *this;
+				}
 
-				using iterator			= typename oi_single::iterator;
-				using const_iterator	= typename oi_single::const_iterator;
-
-				using allocator_type	= typename oi_single::allocator_type;
-
-				// Constructors:
-
-				using oi_base<Key, Value, Allocator, Map, STL>::oi_base;
-				using oi_base<Key, Value, Allocator, Map, STL>::operator=;
-				oi_single& operator=(std::initializer_list<value_type> il) {
-					insert(il);
-					return *this;
+				iterator begin() noexcept {
+					return iterator(_leftmost(_root), this);
 				}
-
-				// Element Access:
-
-				mapped_type& operator[](const key_type& key) {
-					return (*((this->insert(std::make_pair(key, mapped_type()))).first)).second;
+				const_iterator begin() const noexcept {
+					return const_iterator(_leftmost(_root), this);
 				}
-				mapped_type& operator[](key_type&& key) {
-					return (*((this->insert(std::make_pair(std::forward<key_type>(key), mapped_type()))).first)).second;
+				iterator end() noexcept {
+					return iterator(nullptr, this);
+				}
+				const_iterator end() const noexcept {
+					return const_iterator(nullptr, this);
 				}
 
-				mapped_type& at(const key_type& key) {
-					return this->_map.at(key)->second;
+				bool empty() const noexcept {
+					return _size == 0;
 				}
-				const mapped_type& at(const key_type& key) const {
-					return this->_map.at(key)->second;
+				size_type size() const noexcept {
+					return _size;
 				}
 
-				// Modifiers:
-
-				std::pair<iterator, bool> insert(const value_type& val) {
-					typename _map_t::iterator it_key = this->_map.find(val.first);
-					if(it_key != this->_map.end()) {
-						return std::pair<iterator, bool>(it_key->second, false);
-					}
-					this->_list.push_back(val);
-					iterator it_list = --this->_list.end();
-					this->_map.emplace_hint(it_key, it_list->first, it_list);
-					return std::pair<iterator, bool>(it_list, true);
+				iterator find(const key_type& key) {
+					return iterator(_find(key), this);
 				}
-				template<typename P, typename = typename std::enable_if<std::is_constructible<value_type, P&&>::value>::type>
-				std::pair<iterator, bool> insert(P&& val) {
-					typename _map_t::iterator it_key = this->_map.find(val.first);
-					if(it_key != this->_map.end()) {
-						return std::pair<iterator, bool>(it_key->second, false);
-					}
-					this->_list.push_back(std::forward<P>(val));
-					iterator it_list = --this->_list.end();
-					this->_map.emplace_hint(it_key, it_list->first, it_list);
-					return std::pair<iterator, bool>(it_list, true);
+				const_iterator find(const key_type& key) const {
+					return const_iterator(_find(key), this);
 				}
-				iterator insert(const_iterator hint, const value_type& val) {
-					return insert(val).first;
+				size_type count(const key_type& key) const {
+					std::pair<const_iterator, const_iterator> range = equal_range(key);
+					return static_cast<size_type>(std::distance(range.first, range.second));
 				}
-				template<typename P, typename = typename std::enable_if<std::is_constructible<value_type, P&&>::value>::type>
-				iterator insert(const_iterator hint, P&& val) {
-					return insert(std::forward<P>(val)).first;
+				iterator lower_bound(const key_type& key) {
+					return iterator(_lower_bound(key), this);
 				}
-				template<class InputIterator>
-				void insert(InputIterator left, InputIterator right) {
-					for(; left != right; ++left)
-						insert(*left);
+				const_iterator lower_bound(const key_type& key) const {
+					return const_iterator(_lower_bound(key), this);
 				}
-				void insert(std::initializer_list<value_type> init_list) {
-					insert(init_list.begin(), init_list.end());
+				iterator upper_bound(const key_type& key) {
+					return iterator(_upper_bound(key), this);
+				}
+				const_iterator upper_bound(const key_type& key) const {
+					return const_iterator(_upper_bound(key), this);
+				}
+				std::pair<iterator, iterator> equal_range(const key_type& key) {
+					return std::pair<iterator, iterator>(lower_bound(key), upper_bound(key));
+				}
+				std::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+					return std::pair<const_iterator, const_iterator>(lower_bound(key), upper_bound(key));
 				}
 
-				iterator erase(const_iterator pos) {
-					this->_map.erase(pos->first);
-					return this->_list.erase(pos);
+			private:
+
+				Node*			_root;
+				size_type		_size;
+				std::uint32_t	_random;
+				KeyFn			_key;
+				Compare			_less;
+
+				static ordered_hook<Node>& _hook(Node* node) {
+					return std::get<I>(node->hooks);
 				}
-				size_type erase(const key_type& key) {
-					typename _map_t::const_iterator it = this->_map.find(key);
-					if(it != this->_map.end()) {
-						this->_list.erase(it->second);
-						this->_map.erase(it);
-						return 1;
+				static Node* _leftmost(Node* node) {
+					if(node)
+						while(_hook(node).left)
+							node = _hook(node).left;
+					return node;
+				}
+				static Node* _rightmost(Node* node) {
+					if(node)
+						while(_hook(node).right)
+							node = _hook(node).right;
+					return node;
+				}
+				static Node* _next(Node* node) {
+					if(_hook(node).right)
+						return _leftmost(_hook(node).right);
+					Node* parent = _hook(node).parent;
+					while(parent && node == _hook(parent).right) {
+						node = parent;
+						parent = _hook(node).parent;
 					}
-					return 0;
+					return parent;
 				}
-				iterator erase(const_iterator left, const_iterator right) {
-					iterator it;
-					while(left != right)
-						it = erase(left++);
-					return it;
+				Node* _prev(Node* node) const {
+					if(!node)
+						return _rightmost(_root);
+					if(_hook(node).left)
+						return _rightmost(_hook(node).left);
+					Node* parent = _hook(node).parent;
+					while(parent && node == _hook(parent).left) {
+						node = parent;
+						parent = _hook(node).parent;
+					}
+					return parent;
 				}
 
-				template<class... Args>
-				std::pair<iterator, bool> emplace(Args&&... args) {
-					return insert(std::pair<Args...>(std::forward<Args>(args)...));
+				Node* _lower_bound(const key_type& key) const {
+					Node* node = _root;
+					Node* bound = nullptr;
+					while(node) {
+						if(!_less(_key(node->value.second), key)) {
+							bound = node;
+							node = _hook(node).left;
+						}
+						else
+							node = _hook(node).right;
+					}
+					return bound;
 				}
-				template<class... Args>
-				iterator emplace_hint(const_iterator hint, Args&&... args) {
-					return insert(std::pair<Args...>(std::forward<Args>(args)...)).first;
+				Node* _upper_bound(const key_type& key) const {
+					Node* node = _root;
+					Node* bound = nullptr;
+					while(node) {
+						if(_less(key, _key(node->value.second))) {
+							bound = node;
+							node = _hook(node).left;
+						}
+						else
+							node = _hook(node).right;
+					}
+					return bound;
+				}
+				Node* _find(const key_type& key) const {
+					Node* node = _lower_bound(key);
+					return node && !_less(key, _key(node->value.second)) ? node : nullptr;
 				}
 
-				// Operations:
+				void _replace(Node* node, Node* child) {
+					Node* parent = _hook(node).parent;
+					if(!parent)
+						_root = child;
+					else if(_hook(parent).left == node)
+						_hook(parent).left = child;
+					else
+						_hook(parent).right = child;
+					if(child)
+						_hook(child).parent = parent;
+				}
+				void _rotate_up(Node* node) {
+					Node* parent = _hook(node).parent;
+					_replace(parent, node);
+					if(_hook(parent).left == node) {
+						_hook(parent).left = _hook(node).right;
+						if(_hook(node).right)
+							_hook(_hook(node).right).parent = parent;
+						_hook(node).right = parent;
+					}
+					else {
+						_hook(parent).right = _hook(node).left;
+						if(_hook(node).left)
+							_hook(_hook(node).left).parent = parent;
+						_hook(node).left = parent;
+					}
+					_hook(parent).parent = node;
+				}
 
-				std::pair<iterator, iterator> equal_range(const key_type& key) {
-					std::pair<typename _map_t::iterator, typename _map_t::iterator> ret = this->_map.equal_range(key);
-					return std::pair<iterator, iterator>(ret.first->second, ret.second->second);
+				void _link(Node* node) {
+					ordered_hook<Node>& hook = _hook(node);
+					_random ^= _random << 13;
+					_random ^= _random >> 17;
+					_random ^= _random << 5;
+					hook.priority = _random;
+					hook.left = hook.right = nullptr;
+					Node* parent = nullptr;
+					Node** link = &_root;
+					while(*link) {
+						parent = *link;
+						link = _less(_key(node->value.second), _key(parent->value.second)) ? &_hook(parent).left : &_hook(parent).right;
+					}
+					*link = node;
+					hook.parent = parent;
+					while(hook.parent && _hook(hook.parent).priority < hook.priority)
+						_rotate_up(node);
+					++_size;
 				}
-				std::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
-					std::pair<typename _map_t::const_iterator, typename _map_t::const_iterator> ret = this->_map.equal_range(key);
-					return std::pair<const_iterator, const_iterator>(ret.first->second, ret.second->second);
+				void _unlink(Node* node) {
+					ordered_hook<Node>& hook = _hook(node);
+					while(hook.left && hook.right)
+						_rotate_up(_hook(hook.left).priority > _hook(hook.right).priority ? hook.left : hook.right);
+					_replace(node, hook.left ? hook.left : hook.right);
+					--_size;
+				}
+				void _clear() {
+					_root = nullptr;
+					_size = 0;
 				}
 
-		};
+				template<class, class, class> friend class secondary_iter;
+				template<class, class...> friend class indexed_table;
 
-		template<class Key, class Value, class Allocator, class Map, template<class...> class STL>
-		class oi_multi : public oi_base<Key, Value, Allocator, Map, STL> {
+		};
 
-			protected:
+		template<class Node, class Sequence, class... Indexes> struct index_tables;
+		template<class Node, std::size_t... Is, class... Indexes>
+		struct index_tables<Node, index_seq<Is...>, Indexes...> {
+			using type = std::tuple<typename Indexes::template index<Node, Is>...>;
+		};
 
-				using _list_t			= typename oi_multi::_list_t;
-				using _map_t			= typename oi_multi::_map_t;
+		template<class Tag, class... Indexes>
+		struct index_position : std::integral_constant<std::size_t, 0> {};
+		template<class Tag, class First, class... Rest>
+		struct index_position<Tag, First, Rest...> : std::integral_constant<std::size_t, std::is_same<Tag, typename First::tag>::value ? 0 : 1 + index_position<Tag, Rest...>::value> {};
 
-			public:
+		template<class Map, class... Indexes>
+		class indexed_table : public Map { // primary index of a map with secondary indexes
 
-				// Member Types
+			private:
 
-				using key_type			= typename oi_multi::key_type;
-				using mapped_type		= typename oi_multi::mapped_type;
-				using value_type		= typename oi_multi::value_type;
-				using size_type			= typename oi_multi::size_type;
+				using node_t	= typename index_node_of<typename Map::mapped_type>::type;
+				using tables_t	= typename index_tables<node_t, typename make_index_seq<sizeof...(Indexes)>::type, Indexes...>::type;
 
-				using iterator			= typename oi_multi::iterator;
-				using const_iterator	= typename oi_multi::const_iterator;
-				using m_iterator		= typename oi_multi::m_iterator;
-				using m_const_iterator	= typename oi_multi::m_const_iterator;
+				tables_t _indexes;
 
-				using allocator_type	= typename oi_multi::allocator_type;
+			public:
 
-				// Constructors:
+				using Map::Map;
+				indexed_table() {}
+				explicit indexed_table(Map&& primary) : Map(std::move(primary)) {}
 
-				using oi_base<Key, Value, Allocator, Map, STL>::oi_base;
-				using oi_base<Key, Value, Allocator, Map, STL>::operator=;
-				oi_multi& operator=(std::initializer_list<value_type> il) {
-					insert(il);
-					return *this;
+				template<class Tag>
+				typename std::tuple_element<index_position<Tag, Indexes...>::value, tables_t>::type& get() {
+					return std::get<index_position<Tag, Indexes...>::value>(_indexes);
+				}
+				template<class Tag>
+				const typename std::tuple_element<index_position<Tag, Indexes...>::value, tables_t>::type& get() const {
+					return std::get<index_position<Tag, Indexes...>::value>(_indexes);
+				}
+				template<std::size_t N>
+				typename std::tuple_element<N, tables_t>::type& get() {
+					return std::get<N>(_indexes);
+				}
+				template<std::size_t N>
+				const typename std::tuple_element<N, tables_t>::type& get() const {
+					return std::get<N>(_indexes);
 				}
 
-				// Modifiers:
-
-				iterator insert(const value_type& val) {
-					this->_list.push_back(val);
-					iterator it_list = --this->_list.end();
-					this->_map.emplace(it_list->first, it_list);
-					return it_list;
+				template<class Hint, class... Args>
+				typename Map::iterator emplace_hint(Hint hint, Args&&... args) {
+					typename Map::size_type size = this->size();
+					typename Map::iterator it = Map::emplace_hint(hint, std::forward<Args>(args)...);
+					if(this->size() != size) {
+						_node(it->second)->self = it->second;
+						_link(_node(it->second));
+					}
+					return it;
 				}
-				template<typename P, typename = typename std::enable_if<std::is_constructible<value_type, P&&>::value>::type>
-				iterator insert(P&& val) {
-					this->_list.push_back(std::forward<P>(val));
-					iterator it_list = --this->_list.end();
-					this->_map.emplace(it_list->first, it_list);
-					return it_list;
+
+				typename Map::iterator erase(typename Map::const_iterator pos) {
+					_unlink(_node(pos->second));
+					return Map::erase(pos);
 				}
-				iterator insert(const_iterator hint, const value_type& val) {
-					return insert(val);
+				typename Map::iterator erase(typename Map::iterator pos) {
+					return erase(typename Map::const_iterator(pos));
 				}
-				template<typename P, typename = typename std::enable_if<std::is_constructible<value_type, P&&>::value>::type>
-				iterator insert(const_iterator hint, P&& val) {
-					return insert(std::forward<P>(val));
+				typename Map::size_type erase(const typename Map::key_type& key) {
+					typename Map::const_iterator it = this->find(key);
+					if(it == this->end())
+						return 0;
+					erase(it);
+					return 1;
 				}
-				template<class InputIterator>
-				void insert(InputIterator left, InputIterator right) {
-					for(; left != right; ++left)
-						insert(*left);
+
+				void clear() noexcept {
+					Map::clear();
+					_clear();
 				}
-				void insert(std::initializer_list<value_type> init_list) {
-					insert(init_list.begin(), init_list.end());
+				void swap(indexed_table& other) {
+					Map::swap(other);
+					std::swap(_indexes, other._indexes);
 				}
 
-				iterator erase(const_iterator pos) {
-					std::pair<typename _map_t::iterator, typename _map_t::iterator> eq = this->_map.equal_range(pos->first);
-					for(typename _map_t::iterator it = eq.first; it != eq.second; ++it) { // cannot use erase(pos->first) like oi_map since it would delete all the keys
-						if(it->second == pos) {
-							this->_map.erase(it);
-							break;
-						}
+				template<class Fn>
+				void modify(const const_iter<node_t>& pos, Fn&& fn) {
+					node_t* node = const_cast<node_t*>(&*static_cast<const typename std::list<node_t>::const_iterator&>(pos));
+					_unlink(node);
+					try {
+						fn(node->value.second);
 					}
-					return this->_list.erase(pos);
-				}
-				size_type erase(const key_type& key) {
-					std::pair<typename _map_t::const_iterator, typename _map_t::const_iterator> range = this->_map.equal_range(key);
-					size_type count = 0;
-					for(typename _map_t::const_iterator it = range.first; it != range.second; ++it) {
-						this->_list.erase(it->second);
-						++count;
+					catch(...) {
+						_link(node);
+						throw;
 					}
-					this->_map.erase(range.first, range.second);
-					return count;
-				}
-				iterator erase(const_iterator left, const_iterator right) {
-					iterator it;
-					while(left != right)
-						it = erase(left++);
-					return it;
+					_link(node);
 				}
 
-				template<class... Args>
-				iterator emplace(Args&&... args) {
-					return insert(std::pair<Args...>(std::forward<Args>(args)...));
-				}
-				template<class... Args>
-				iterator emplace_hint(const_iterator hint, Args&&... args) {
-					return insert(std::pair<Args...>(std::forward<Args>(args)...));
-				}
+			private:
 
-				// Operations:
+				static node_t* _node(const iter<node_t>& it) {
+					return &*static_cast<const typename std::list<node_t>::iterator&>(it);
+				}
 
-				std::pair<m_iterator, m_iterator> equal_range(const key_type& key) {
-					std::pair<typename _map_t::iterator, typename _map_t::iterator> ret = this->_map.equal_range(key);
-					return std::pair<m_iterator, m_iterator>(ret.first, ret.second);
+				template<std::size_t N = 0>
+				typename std::enable_if<N < sizeof...(Indexes)>::type _link(node_t* node) {
+					std::get<N>(_indexes)._link(node);
+					_link<N + 1>(node);
 				}
-				std::pair<m_const_iterator, m_const_iterator> equal_range(const key_type& key) const {
-					std::pair<typename _map_t::const_iterator, typename _map_t::const_iterator> ret = this->_map.equal_range(key);
-					return std::pair<m_const_iterator, m_const_iterator>(ret.first, ret.second);
+				template<std::size_t N = 0>
+				typename std::enable_if<N == sizeof...(Indexes)>::type _link(node_t*) {}
+				template<std::size_t N = 0>
+				typename std::enable_if<N < sizeof...(Indexes)>::type _unlink(node_t* node) {
+					std::get<N>(_indexes)._unlink(node);
+					_unlink<N + 1>(node);
 				}
+				template<std::size_t N = 0>
+				typename std::enable_if<N == sizeof...(Indexes)>::type _unlink(node_t*) {}
+				template<std::size_t N = 0>
+				typename std::enable_if<N < sizeof...(Indexes)>::type _clear() {
+					std::get<N>(_indexes)._clear();
+					_clear<N + 1>();
+				}
+				template<std::size_t N = 0>
+				typename std::enable_if<N == sizeof...(Indexes)>::type _clear() {}
 
 		};
 
-		template<class OiBase>
-		class oi_ordered : public OiBase {
+		template<class Map, class... Indexes>
+		indexed_table<Map, Indexes...> index_like(const indexed_table<Map, Indexes...>& other, std::size_t n) {
+			return indexed_table<Map, Indexes...>(index_like(static_cast<const Map&>(other), n));
+		}
 
-			protected:
+		template<class Map, class... Indexes>
+		struct with_indexes {
+			using type = indexed_table<Map, Indexes...>;
+		};
+		template<class Map>
+		struct with_indexes<Map> {
+			using type = Map;
+		};
 
-				using _map_t					= typename oi_ordered::_map_t;
+		template<class Iter, class Stored>
+		class seq_range { // elements of a key range by seq(), a heap of cursors (one per key, over its group if it has one) merged as it's walked
 
 			public:
 
-				// Member Types:
+				using value_type	= typename std::iterator_traits<Iter>::value_type;
+				using size_type		= std::size_t;
 
-				using value_type				= typename oi_ordered::value_type;
+				class iterator { // single pass, incrementing any copy advances the range
 
-				using iterator					= typename oi_ordered::iterator;
-				using const_iterator			= typename oi_ordered::const_iterator;
-				using reverse_iterator			= std::reverse_iterator<iterator>;
-				using const_reverse_iterator	= std::reverse_iterator<const_iterator>;
+					public:
 
-				using allocator_type			= typename oi_ordered::allocator_type;
+						using iterator_category = std::input_iterator_tag;
+						using value_type		= typename std::iterator_traits<Iter>::value_type;
+						using difference_type	= typename std::iterator_traits<Iter>::difference_type;
+						using pointer			= typename std::iterator_traits<Iter>::pointer;
+						using reference			= typename std::iterator_traits<Iter>::reference;
 
-				using key_compare				= typename _map_t::key_compare;
-				using value_compare				= typename _map_t::value_compare;
+						iterator() : _range(nullptr) {}
+						explicit iterator(seq_range* range) : _range(range) {}
 
-				// Constructors:
+						friend bool operator==(const iterator& left, const iterator& right) {
+							return left._done() == right._done();
+						}
+						friend bool operator!=(const iterator& left, const iterator& right) {
+							return !(left == right);
+						}
 
-				using OiBase::OiBase;
-				oi_ordered() {}
-				explicit oi_ordered(const key_compare& comp, const allocator_type& alloc = allocator_type()) : OiBase(alloc, comp) {}
-				template<class InputIterator>
-				oi_ordered(InputIterator left, InputIterator right, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) :oi_ordered(comp, alloc) {
-					this->insert(left, right);
-				}
-				template<class InputIterator>
-				oi_ordered(InputIterator left, InputIterator right, const allocator_type& alloc) : oi_ordered(left, right, key_compare(), alloc) {}
-				oi_ordered(std::initializer_list<value_type> il, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) : oi_ordered(comp, alloc) {
-					this->insert(il);
-				}
-				oi_ordered(std::initializer_list<value_type> il, const allocator_type& alloc) : oi_ordered(il, key_compare(), alloc) {}
+						iterator& operator++() {
+							_range->_pop();
+							return *this;
+						}
+						Iter operator++(int) {
+							Iter tmp = base();
+							_range->_pop();
+							return tmp;
+						}
 
-				// Iterators:
+						reference operator*() const {
+							return *base();
+						}
+						pointer operator->() const {
+							return &*base();
+						}
 
-				reverse_iterator rbegin() noexcept {
-					return this->_list.rbegin();
+						Iter base() const { // the element as an iterator of the map
+							return *_range->_heap.front().first;
+						}
+
+					private:
+
+						seq_range* _range;
+
+						bool _done() const noexcept {
+							return _range == nullptr || _range->_heap.empty();
+						}
+
+				};
+
+				seq_range() {}
+
+				iterator begin() {
+					return iterator(this);
 				}
-				const_reverse_iterator rbegin() const noexcept {
-					return this->_list.rbegin();
+				iterator end() {
+					return iterator();
 				}
-				const_reverse_iterator crbegin() const noexcept {
-					return this->_list.crbegin();
+
+				bool empty() const noexcept {
+					return _heap.empty();
 				}
-				reverse_iterator rend() noexcept {
-					return this->_list.rend();
+				size_type size() const noexcept { // elements left
+					return _size;
 				}
-				const_reverse_iterator rend() const noexcept {
-					return this->_list.rend();
+
+				void push(const Stored* first, const Stored* last) { // [first, last) sorted by seq()
+					if(first == last)
+						return;
+					_heap.push_back(_cursor{first->seq(), first, last});
+					_size += static_cast<size_type>(last - first);
 				}
-				const_reverse_iterator crend() const noexcept {
-					return this->_list.crend();
+				void seal() {
+					std::make_heap(_heap.begin(), _heap.end(), _later);
 				}
 
-				// Observers:
+			private:
 
-				key_compare key_comp() const {
-					return key_compare();
+				struct _cursor {
+					decltype(std::declval<const Stored&>().seq())	seq; // of *first, kept here so the heap doesn't go through the list nodes
+					const Stored*									first;
+					const Stored*									last;
+				};
+
+				std::vector<_cursor>	_heap;
+				size_type				_size = 0;
+
+				static bool _later(const _cursor& left, const _cursor& right) {
+					return left.seq > right.seq;
 				}
-				value_compare value_comp() const {
-					return value_compare(key_comp());
+				void _pop() {
+					std::pop_heap(_heap.begin(), _heap.end(), _later);
+					--_size;
+					_cursor& back = _heap.back();
+					if(++back.first == back.last) {
+						_heap.pop_back();
+					}
+					else {
+						back.seq = back.first->seq();
+						std::push_heap(_heap.begin(), _heap.end(), _later);
+					}
 				}
 
 		};
 
-		template<class OiBase>
-		class oi_unordered : public OiBase {
+		template<class Key, class Value, class Allocator, class Map>
+		class oi_base {
 
 			protected:
 
-				using _map_t				= typename oi_unordered::_map_t;
-				using _list_t				= typename oi_unordered::_list_t;
+				using _node_t = typename index_node_of<typename Map::mapped_type>::type;
+				using _list_t = std::list<_node_t>;
+				using _map_t  = Map;
+				using _index_t = index_types<_node_t, Map>;
+				using _grouped = std::integral_constant<bool, _index_t::grouped>; // multimaps index each key once, to the group of its elements
+				using _stable = std::integral_constant<bool, _node_t::index_of::stable>;
+				using _group_t = index_group<iter<_node_t>>;
+				using _mapped_ref = typename std::conditional<std::is_const<typename _node_t::access_type>::value, const Value&, Value&>::type;
+
+				_list_t			_list;
+				_map_t			_map;
+				std::uint64_t	_seq = 0;
 
 			public:
 
 				// Member Types:
 
-				using key_type				= typename oi_unordered::key_type;
-				using value_type			= typename oi_unordered::value_type;
-				using size_type				= typename oi_unordered::size_type;
+				using key_type					= Key;
+				using mapped_type				= Value;
+				using value_type				= std::pair<const key_type, mapped_type>;
+				using size_type					= typename _map_t::size_type;
+				using difference_type			= typename _map_t::difference_type;
+				using seq_type					= std::uint64_t;
 
-				using allocator_type		= typename oi_unordered::allocator_type;
+				using allocator_type			= Allocator;
 
-				using hasher				= typename _map_t::hasher;
-				using key_equal				= typename _map_t::key_equal;
+				using pointer					= typename Allocator::pointer;
+				using const_pointer				= typename Allocator::const_pointer;
+				using reference					= typename Allocator::reference;
+				using const_reference			= typename Allocator::const_reference;
+
+				using iterator					= iter<_node_t>;
+				using const_iterator			= const_iter<_node_t>;
 
-				using local_iterator		= local_iter<value_type, std::unordered_map>;
-				using const_local_iterator	= const_local_iter<value_type, std::unordered_map>;
+				using m_iterator				= typename _index_t::m_iterator;
+				using m_const_iterator			= typename _index_t::m_const_iterator;
+				using m_reverse_iterator		= std::reverse_iterator<m_iterator>;
+				using m_const_reverse_iterator	= std::reverse_iterator<m_const_iterator>;
 
 				// Constructors:
 
-				using OiBase::OiBase;
-				oi_unordered() {}
-				explicit oi_unordered(size_type n, const hasher& hf = hasher(), const key_equal& eql = key_equal(), const allocator_type& alloc = allocator_type()) : OiBase(alloc, n, hf, eql) {}
-				explicit oi_unordered(const allocator_type& alloc) : OiBase(alloc) {}
-				oi_unordered(size_type n, const allocator_type& alloc) : oi_unordered(n, hasher(), key_equal(), alloc) {}
-				oi_unordered(size_type n, const hasher& hf, const allocator_type& alloc) : oi_unordered(n, hf, key_equal(), alloc) {}
-				template<class InputIterator>
-				oi_unordered(InputIterator left, InputIterator right) {
-					this->insert(left, right);
-				}
-				template<class InputIterator>
-				oi_unordered(InputIterator left, InputIterator right, size_type n, const hasher& hf = hasher(), const key_equal& eql = key_equal(), const allocator_type& alloc = allocator_type()) : oi_unordered(n, hf, eql, alloc) {
-					this->insert(left, right);
+				oi_base() {}
+				explicit oi_base(const allocator_type& alloc) : _list(alloc) {}
+
+				oi_base(const oi_base& other) : _list(other._list), _map(index_like(other._map, other.size())), _seq(other._seq) {
+					_index_rebuild();
 				}
-				template <class InputIterator>
-				oi_unordered(InputIterator left, InputIterator right, size_type n, const allocator_type& alloc) : oi_unordered(left, right, n, hasher(), key_equal(), alloc()) {}
-				template <class InputIterator>
-				oi_unordered(InputIterator left, InputIterator right, size_type n, const hasher& hf, const allocator_type& alloc) : oi_unordered(left, right, n, hf, key_equal(), alloc) {}
-				oi_unordered(std::initializer_list<value_type> il) {
-					this->insert(il);
+				oi_base(const oi_base& other, const allocator_type& alloc) : _list(alloc) {
+				    *this = other;
+                }
+
+				oi_base(oi_base&&) = default;
+				oi_base(oi_base&& other, const allocator_type& alloc) : _list(alloc) {
+                    *this = std::forward<oi_base>(other);
 				}
-				oi_unordered(std::initializer_list<value_type> il, size_type n, const hasher& hf = hasher(), const key_equal& eql = key_equal(), const allocator_type& alloc = allocator_type()) : oi_unordered(n, hf, eql, alloc) {
-					this->insert(il);
+
+				oi_base& operator=(const oi_base& other) {
+					if(this != &other) {
+						oi_base tmp(other);
+						swap(tmp);
+					}
+					return *this;
 				}
-				oi_unordered(std::initializer_list<value_type> il, size_type n, const allocator_type& alloc) : oi_unordered(il, n, hasher(), key_equal(), alloc) {}
-				oi_unordered(std::initializer_list<value_type> il, size_type n, const hasher& hf, const allocator_type& alloc) : oi_unordered(il, n, hf, key_equal(), alloc) {}
+				oi_base& operator=(oi_base&&) = default;
 
 				// Iterators:
 
-				using OiBase::begin;
-				using OiBase::cbegin;
-				using OiBase::end;
-				using OiBase::cend;
-
-				local_iterator begin(size_type n) {
-					return this->_map.begin(n);
+				iterator begin() noexcept {
+					return _list.begin();
 				}
-				const_local_iterator begin(size_type n) const {
-					return this->_map.begin(n);
+				const_iterator begin() const noexcept {
+					return _list.begin();
 				}
-				const_local_iterator cbegin(size_type n) const {
-					return this->_map.cbegin(n);
+				const_iterator cbegin() const noexcept {
+					return _list.cbegin();
 				}
-				local_iterator end(size_type n) {
-					return this->_map.end(n);
+				iterator end() noexcept {
+					return _list.end();
 				}
-				const_local_iterator end(size_type n) const {
-					return this->_map.end(n);
+				const_iterator end() const noexcept {
+					return _list.end();
 				}
-				const_local_iterator cend(size_type n) const {
-					return this->_map.cend(n);
+				const_iterator cend() const noexcept {
+					return _list.cend();
 				}
 
-				// Buckets:
+				m_iterator m_begin() noexcept {
+					return _map.begin();
+				}
+				m_const_iterator m_begin() const noexcept {
+					return _map.begin();
+				}
+				m_const_iterator m_cbegin() const noexcept {
+					return _map.cbegin();
+				}
+				m_iterator m_end() noexcept {
+					return _map.end();
+				}
+				m_const_iterator m_end() const noexcept {
+					return _map.end();
+				}
+				m_const_iterator m_cend() const noexcept {
+					return _map.cend();
+				}
 
-				size_type bucket_count() const noexcept {
-					return this->_map.bucket_count();
+				m_reverse_iterator m_rbegin() noexcept {
+					return _map.rbegin();
 				}
-				size_type max_bucket_count() const noexcept {
-					return this->_map.max_bucket_count();
+				m_const_reverse_iterator m_rbegin() const noexcept {
+					return _map.rbegin();
 				}
-				size_type bucket_size(size_type n) const {
-					return this->_map.bucket_size(n);
+				m_const_reverse_iterator m_crbegin() const noexcept {
+					return _map.crbegin();
 				}
-				size_type bucket(const key_type& key) const {
-					return this->_map.bucket(key);
+				m_reverse_iterator m_rend() noexcept {
+					return _map.rend();
+				}
+				m_const_reverse_iterator m_rend() const noexcept {
+					return _map.rend();
+				}
+				m_const_reverse_iterator m_crend() const noexcept {
+					return _map.crend();
 				}
 
-				// Hash Policy:
+				// Capacity:
 
-				float load_factor() const noexcept {
-					return this->_map.load_factor();
+				bool empty() const noexcept {
+					return _list.empty();
 				}
-				float max_load_factor() const noexcept {
-					return this->_map.max_load_factor();
+				size_type size() const noexcept {
+					return _list.size();
 				}
-				void max_load_factor(float f) {
-					this->_map.max_load_factor(f);
+				size_type max_size() const noexcept {
+					return _list.max_size();
 				}
-				void rehash(size_type n) {
-					this->_map.rehash(n);
+
+				// Modifiers:
+
+				void swap(oi_base& other) {
+					_list.swap(other._list);
+					_map.swap(other._map);
+					std::swap(_seq, other._seq);
 				}
-				void reserve(size_type n) {
-					this->_map.reserve(n);
+
+				void clear() noexcept {
+					_list.clear();
+					_map.clear();
 				}
 
-				// Observers:
+				// Operations:
 
-				hasher hash_function() const {
-					return hasher();
+				iterator find(const key_type& key) {
+					typename _map_t::iterator it_map = _map.find(key);
+					return it_map != _map.end() ? _index_front(it_map->second) : end();
 				}
-				key_equal key_eq() const {
-					return key_equal();
+				const_iterator find(const key_type& key) const {
+					typename _map_t::const_iterator it_map = _map.find(key);
+					return it_map != _map.end() ? _index_front(it_map->second) : end();
 				}
 
-		};
+				size_type count(const key_type& key) const {
+					typename _map_t::const_iterator it_map = _map.find(key);
+					return it_map != _map.end() ? _index_count(it_map->second) : 0;
+				}
 
-	}
+				// Allocator:
 
-	template<class Key, class Value, class Predicate = std::less<Key>, class Allocator = std::allocator<std::pair<const Key, Value>>>
-	class oi_map : public __oi_map_details::oi_ordered<__oi_map_details::oi_single<Key, Value, Allocator, std::map<Key, typename std::list<std::pair<const Key, Value>>::iterator, Predicate>, std::map>> {
-		public:
-			using __oi_map_details::oi_ordered<__oi_map_details::oi_single<Key, Value, Allocator, std::map<Key, typename std::list<std::pair<const Key, Value>>::iterator, Predicate>, std::map>>::oi_ordered;
-			typename oi_map::iterator lower_bound(const typename oi_map::key_type& key) {
-				return this->_map.lower_bound(key)->second;
-			}
-			typename oi_map::const_iterator lower_bound(const typename oi_map::key_type& key) const {
-				return this->_map.lower_bound(key)->second;
-			}
-			typename oi_map::iterator upper_bound(const typename oi_map::key_type& key) {
-				return this->_map.upper_bound(key)->second;
-			}
-			typename oi_map::const_iterator upper_bound(const typename oi_map::key_type& key) const {
-				return this->_map.upper_bound(key)->second;
-			}
-	};
+				allocator_type get_allocator() const noexcept {
+					return allocator_type();
+				}
 
-	template<class Key, class Value, class Predicate = std::less<Key>, class Allocator = std::allocator<std::pair<const Key, Value>>>
-	class oi_multimap : public __oi_map_details::oi_ordered<__oi_map_details::oi_multi<Key, Value, Allocator, std::multimap<Key, typename std::list<std::pair<const Key, Value>>::iterator, Predicate>, std::multimap>> {
-		public:
-			using __oi_map_details::oi_ordered<__oi_map_details::oi_multi<Key, Value, Allocator, std::multimap<Key, typename std::list<std::pair<const Key, Value>>::iterator, Predicate>, std::multimap>>::oi_ordered;
-			typename oi_multimap::m_iterator lower_bound(const typename oi_multimap::key_type& key) {
-				return this->_map.lower_bound(key);
-			}
-			typename oi_multimap::m_const_iterator lower_bound(const typename oi_multimap::key_type& key) const {
-				return this->_map.lower_bound(key);
-			}
-			typename oi_multimap::m_iterator upper_bound(const typename oi_multimap::key_type& key) {
-				return this->_map.upper_bound(key);
-			}
-			typename oi_multimap::m_const_iterator upper_bound(const typename oi_multimap::key_type& key) const {
-				return this->_map.upper_bound(key);
-			}
-	};
+				// Extra:
 
-	template<class Key, class Value, class Hash = std::hash<Key>, class Predicate = std::equal_to<Key>, class Allocator = std::allocator<std::pair<const Key, Value>>>
-	class oi_unordered_map : public __oi_map_details::oi_unordered<__oi_map_details::oi_single<Key, Value, Allocator, std::unordered_map<Key, typename std::list<std::pair<const Key, Value>>::iterator, Hash, Predicate>, std::unordered_map>> {
-		public:
-			using __oi_map_details::oi_unordered<__oi_map_details::oi_single<Key, Value, Allocator, std::unordered_map<Key, typename std::list<std::pair<const Key, Value>>::iterator, Hash, Predicate>, std::unordered_map>>::oi_unordered;
-	};
+				void splice(const_iterator position, const_iterator element) {
+					_list.splice(position, _list, element);
+				}
+				void splice(const_iterator position, const_iterator left, const_iterator right) {
+					_list.splice(position, _list, left, right);
+				}
+				void move_to_front(const_iterator element) {
+					_list.splice(_list.begin(), _list, element);
+				}
 
-	template<class Key, class Value, class Hash = std::hash<Key>, class Predicate = std::equal_to<Key>, class Allocator = std::allocator<std::pair<const Key, Value>>>
-	class oi_unordered_multimap : public __oi_map_details::oi_unordered<__oi_map_details::oi_multi<Key, Value, Allocator, std::unordered_multimap<Key, typename std::list<std::pair<const Key, Value>>::iterator, Hash, Predicate>, std::unordered_multimap>> {
-		public:
-			using __oi_map_details::oi_unordered<__oi_map_details::oi_multi<Key, Value, Allocator, std::unordered_multimap<Key, typename std::list<std::pair<const Key, Value>>::iterator, Hash, Predicate>, std::unordered_multimap>>::oi_unordered;
-	};
+				template<class Compare>
+				void sort_order(Compare comp, unsigned threads = 1) { // stable, only relinks the list, threads > 1 sorts big lists in chunks concurrently (comp is copied to each thread)
+					size_type chunk = _list.size() / (threads != 0 ? threads : 1);
+					if(threads < 2 || chunk < 8192) {
+						_list.sort([&comp](const _node_t& left, const _node_t& right) { return comp(left.value, right.value); });
+						return;
+					}
+					std::vector<_list_t> parts;
+					parts.reserve(threads);
+					for(unsigned i = 0; i < threads; ++i) {
+						typename _list_t::iterator last = i + 1 < threads ? std::next(_list.begin(), chunk) : _list.end();
+						parts.emplace_back(_list.get_allocator());
+						parts.back().splice(parts.back().end(), _list, _list.begin(), last);
+					}
+					std::vector<std::exception_ptr> errors(threads);
+					auto sort_part = [&parts, &errors, comp](std::size_t i) mutable {
+						try {
+							parts[i].sort([&comp](const _node_t& left, const _node_t& right) { return comp(left.value, right.value); });
+						}
+						catch(...) {
+							errors[i] = std::current_exception();
+						}
+					};
+					std::vector<std::thread> workers;
+					try {
+						for(std::size_t i = 1; i < parts.size(); ++i)
+							workers.emplace_back(sort_part, i);
+						sort_part(0);
+					}
+					catch(...) {
+						errors[0] = std::current_exception();
+					}
+					for(std::thread& worker : workers)
+						worker.join();
+					try {
+						for(std::exception_ptr& error : errors)
+							if(error)
+								std::rethrow_exception(error);
+						for(std::size_t step = 1; step < parts.size(); step *= 2) // merging neighbours keeps it stable
+							for(std::size_t i = 0; i + step < parts.size(); i += 2 * step)
+								parts[i].merge(parts[i + step], [&comp](const _node_t& left, const _node_t& right) { return comp(left.value, right.value); });
+					}
+					catch(...) { // every element goes back to the list, the index still points to them
+						for(_list_t& part : parts)
+							_list.splice(_list.end(), part);
+						throw;
+					}
+					_list.splice(_list.end(), parts.front());
+				}
+				template<class Predicate>
+				iterator stable_partition_order(Predicate pred) { // the elements satisfying pred go first, returns the first one that doesn't
+					_list_t rest(_list.get_allocator());
+					try {
+						for(typename _list_t::iterator it = _list.begin(); it != _list.end();) {
+							typename _list_t::iterator cur = it++;
+							if(!pred(cur->value))
+								rest.splice(rest.end(), _list, cur);
+						}
+					}
+					catch(...) {
+						_list.splice(_list.end(), rest);
+						throw;
+					}
+					iterator ret = rest.empty() ? _list.end() : rest.begin();
+					_list.splice(_list.end(), rest);
+					return ret;
+				}
+				void reverse_order() noexcept {
+					_list.reverse();
+				}
+
+				void pop_front() {
+					_index_erase(cbegin());
+					_list.pop_front();
+				}
+				size_type trim_front(size_type n) {
+					return trim_front(n, [](value_type&) {});
+				}
+				template<class Fn>
+				size_type trim_front(size_type n, Fn&& on_evict) {
+					size_type count = 0;
+					for(; count < n && !_list.empty(); ++count) {
+						on_evict(_list.front().value);
+						pop_front();
+					}
+					return count;
+				}
+				size_type trim_front_before(seq_type seq) {
+					return trim_front_before(seq, [](value_type&) {});
+				}
+				template<class Fn>
+				size_type trim_front_before(seq_type seq, Fn&& on_evict) {
+					size_type count = 0;
+					for(; !_list.empty() && _list.front().seq < seq; ++count) {
+						on_evict(_list.front().value);
+						pop_front();
+					}
+					return count;
+				}
+
+				seq_type next_seq() const noexcept {
+					return _seq;
+				}
+
+				void compact() { // strong guarantee, values are only moved out when that can't throw and are moved back if an allocation fails
+					_list_t list(_list.get_allocator());
+					_map_t map = index_like(_map, _list.size());
+					try {
+						for(_node_t& node : _list)
+							list.emplace_back(node.seq, std::move_if_noexcept(node.value));
+						_index_rebuild(map, list);
+					}
+					catch(...) {
+						_compact_restore(list, std::integral_constant<bool, std::is_nothrow_move_constructible<value_type>::value || !std::is_copy_constructible<value_type>::value>());
+						throw;
+					}
+					_list.swap(list);
+					_map.swap(map);
+				}
+
+			protected:
+
+				template<class... Args>
+				oi_base(const allocator_type& alloc, Args&&... args) : _list(alloc), _map(args...) {}
+
+				static const iterator& _index_front(const iterator& it) {
+					return it;
+				}
+				static const iterator& _index_front(const _group_t& group) {
+					return group.front();
+				}
+				static size_type _index_count(const iterator&) {
+					return 1;
+				}
+				static size_type _index_count(const _group_t& group) {
+					return group.size();
+				}
+				static std::pair<const iterator*, const iterator*> _index_span(const iterator& it) {
+					return std::pair<const iterator*, const iterator*>(&it, &it + 1);
+				}
+				static std::pair<const iterator*, const iterator*> _index_span(const _group_t& group) {
+					return std::pair<const iterator*, const iterator*>(group.data(), group.data() + group.size());
+				}
+				static typename _group_t::iterator _group_find(_group_t& group, seq_type seq) { // groups are sorted by seq, even after splice() reorders the list
+					return std::lower_bound(group.begin(), group.end(), seq, [](const iterator& it, seq_type value) { return it.seq() < value; });
+				}
+
+				void _index_rebuild() { // points a fresh index to the elements of _list, the index values of a copied _map would still point to the source list
+					_index_rebuild(_map, _list);
+				}
+				static void _index_rebuild(_map_t& map, _list_t& list) {
+					_index_rebuild(map, list, _grouped());
+				}
+				static void _index_rebuild(_map_t& map, _list_t& list, std::false_type) {
+					for(iterator it = list.begin(); it != list.end(); ++it)
+						_index_set(it, map.emplace_hint(map.end(), it->first, it));
+				}
+				static void _index_rebuild(_map_t& map, _list_t& list, std::true_type) {
+					for(iterator it = list.begin(); it != list.end(); ++it) {
+						typename _map_t::iterator it_map = map.emplace_hint(map.end(), it->first, _group_t());
+						_group_t& group = it_map->second;
+						group.insert(group.empty() || group.back().seq() < it.seq() ? group.end() : _group_find(group, it.seq()), it);
+						_index_set(it, it_map);
+					}
+				}
+
+				void _index_insert(typename _map_t::iterator hint, iterator it) {
+					_index_set(it, _map.emplace_hint(hint, it->first, it));
+				}
+				void _index_insert(iterator it) {
+					typename _map_t::iterator it_map = _map.find(it->first);
+					if(it_map == _map.end())
+						it_map = _map.emplace_hint(it_map, it->first, _group_t());
+					it_map->second.push_back(it);
+					_index_set(it, it_map);
+				}
+
+				static _node_t& _node(const_iterator it) {
+					return const_cast<_node_t&>(*static_cast<const typename _list_t::const_iterator&>(it));
+				}
+				static void _index_set(iterator it, typename _map_t::iterator it_map) {
+					_index_set(it, it_map, _stable());
+				}
+				static void _index_set(iterator it, typename _map_t::iterator it_map, std::true_type) {
+					_node(it).index = it_map;
+				}
+				static void _index_set(iterator, typename _map_t::iterator, std::false_type) {}
+				typename _map_t::iterator _index_at(const_iterator pos) {
+					return _index_at(pos, _stable());
+				}
+				typename _map_t::iterator _index_at(const_iterator pos, std::true_type) {
+					return _node(pos).index;
+				}
+				typename _map_t::iterator _index_at(const_iterator pos, std::false_type) {
+					return _map.find(pos->first);
+				}
+
+				void _compact_restore(_list_t& moved, std::true_type) { // the first moved.size() elements of _list were moved into moved
+					typename _list_t::iterator it = _list.begin();
+					for(_node_t& node : moved) {
+						it->value.~value_type();
+						::new(static_cast<void*>(&it->value)) value_type(std::move(node.value));
+						++it;
+					}
+				}
+				void _compact_restore(_list_t&, std::false_type) noexcept {} // they were copied
+
+				void _index_erase(const_iterator pos) {
+					_index_erase(pos, _grouped());
+				}
+				void _index_erase(const_iterator pos, std::false_type) {
+					_map.erase(_index_at(pos));
+				}
+				void _index_erase(const_iterator pos, std::true_type) { // a binary search by seq within the group
+					typename _map_t::iterator it_map = _index_at(pos);
+					it_map->second.erase(_group_find(it_map->second, pos.seq()));
+					if(it_map->second.empty())
+						_map.erase(it_map);
+				}
+
+		};
+
+		template<class Key, class Value, class Allocator, class Map>
+		class oi_single : public oi_base<Key, Value, Allocator, Map> {
+
+			protected:
+
+				using _list_t			= typename oi_single::_list_t;
+				using _map_t			= typename oi_single::_map_t;
+				using _mapped_ref		= typename oi_single::_mapped_ref;
+
+			public:
+
+				// Member Types:
+
+				using key_type			= typename oi_single::key_type;
+				using mapped_type		= typename oi_single::mapped_type;
+				using value_type		= typename oi_single::value_type;
+				using size_type			= typename oi_single::size_type;
+
+				using iterator			= typename oi_single::iterator;
+				using const_iterator	= typename oi_single::const_iterator;
+
+				using allocator_type	= typename oi_single::allocator_type;
+
+				// Constructors:
+
+				using oi_base<Key, Value, Allocator, Map>::oi_base;
+				using oi_base<Key, Value, Allocator, Map>::operator=;
+				oi_single& operator=(std::initializer_list<value_type> il) {
+					insert(il);
+					return *this;
+				}
+
+				// Element Access:
+
+				_mapped_ref operator[](const key_type& key) {
+					return (*((this->insert(std::make_pair(key, mapped_type()))).first)).second;
+				}
+				_mapped_ref operator[](key_type&& key) {
+					return (*((this->insert(std::make_pair(std::forward<key_type>(key), mapped_type()))).first)).second;
+				}
+
+				_mapped_ref at(const key_type& key) {
+					return this->_map.at(key)->second;
+				}
+				const mapped_type& at(const key_type& key) const {
+					return this->_map.at(key)->second;
+				}
+
+				// Modifiers:
+
+				std::pair<iterator, bool> insert(const value_type& val) {
+					typename _map_t::iterator it_key = this->_map.find(val.first);
+					if(it_key != this->_map.end()) {
+						return std::pair<iterator, bool>(it_key->second, false);
+					}
+					this->_list.emplace_back(this->_seq++, val);
+					iterator it_list = --this->_list.end();
+					this->_index_insert(it_key, it_list);
+					return std::pair<iterator, bool>(it_list, true);
+				}
+				template<typename P, typename = typename std::enable_if<std::is_constructible<value_type, P&&>::value>::type>
+				std::pair<iterator, bool> insert(P&& val) {
+					typename _map_t::iterator it_key = this->_map.find(val.first);
+					if(it_key != this->_map.end()) {
+						return std::pair<iterator, bool>(it_key->second, false);
+					}
+					this->_list.emplace_back(this->_seq++, std::forward<P>(val));
+					iterator it_list = --this->_list.end();
+					this->_index_insert(it_key, it_list);
+					return std::pair<iterator, bool>(it_list, true);
+				}
+				iterator insert(const_iterator hint, const value_type& val) {
+					return insert(val).first;
+				}
+				template<typename P, typename = typename std::enable_if<std::is_constructible<value_type, P&&>::value>::type>
+				iterator insert(const_iterator hint, P&& val) {
+					return insert(std::forward<P>(val)).first;
+				}
+				template<class InputIterator>
+				void insert(InputIterator left, InputIterator right) {
+					for(; left != right; ++left)
+						insert(*left);
+				}
+				void insert(std::initializer_list<value_type> init_list) {
+					insert(init_list.begin(), init_list.end());
+				}
+
+				iterator erase(const_iterator pos) {
+					this->_index_erase(pos);
+					return this->_list.erase(pos);
+				}
+				size_type erase(const key_type& key) {
+					typename _map_t::const_iterator it = this->_map.find(key);
+					if(it != this->_map.end()) {
+						iterator it_list = it->second;
+						this->_map.erase(it); // the index goes first, secondary indexes still read the element while unlinking it
+						this->_list.erase(it_list);
+						return 1;
+					}
+					return 0;
+				}
+				iterator erase(const_iterator left, const_iterator right) {
+					iterator it;
+					while(left != right)
+						it = erase(left++);
+					return it;
+				}
+
+				template<class... Args>
+				std::pair<iterator, bool> emplace(Args&&... args) {
+					return insert(std::pair<Args...>(std::forward<Args>(args)...));
+				}
+				template<class... Args>
+				iterator emplace_hint(const_iterator hint, Args&&... args) {
+					return insert(std::pair<Args...>(std::forward<Args>(args)...)).first;
+				}
+
+				// Operations:
+
+				std::pair<iterator, iterator> equal_range(const key_type& key) {
+					std::pair<typename _map_t::iterator, typename _map_t::iterator> ret = this->_map.equal_range(key);
+					return std::pair<iterator, iterator>(ret.first->second, ret.second->second);
+				}
+				std::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+					std::pair<typename _map_t::const_iterator, typename _map_t::const_iterator> ret = this->_map.equal_range(key);
+					return std::pair<const_iterator, const_iterator>(ret.first->second, ret.second->second);
+				}
+
+				// Secondary Indexes:
+
+				template<class Index, class M = _map_t>
+				auto get() -> decltype(std::declval<M&>().template get<Index>()) {
+					return this->_map.template get<Index>();
+				}
+				template<class Index, class M = _map_t>
+				auto get() const -> decltype(std::declval<const M&>().template get<Index>()) {
+					return this->_map.template get<Index>();
+				}
+				template<std::size_t N, class M = _map_t>
+				auto get() -> decltype(std::declval<M&>().template get<N>()) {
+					return this->_map.template get<N>();
+				}
+				template<std::size_t N, class M = _map_t>
+				auto get() const -> decltype(std::declval<const M&>().template get<N>()) {
+					return this->_map.template get<N>();
+				}
+
+				template<class Fn>
+				void modify(const_iterator pos, Fn&& fn) {
+					this->_map.modify(pos, std::forward<Fn>(fn));
+				}
+
+		};
+
+		template<class Key, class Value, class Allocator, class Map>
+		class oi_multi : public oi_base<Key, Value, Allocator, Map> {
+
+			protected:
+
+				using _list_t			= typename oi_multi::_list_t;
+				using _map_t			= typename oi_multi::_map_t;
+
+			public:
+
+				// Member Types
+
+				using key_type			= typename oi_multi::key_type;
+				using mapped_type		= typename oi_multi::mapped_type;
+				using value_type		= typename oi_multi::value_type;
+				using size_type			= typename oi_multi::size_type;
+
+				using iterator			= typename oi_multi::iterator;
+				using const_iterator	= typename oi_multi::const_iterator;
+				using m_iterator		= typename oi_multi::m_iterator;
+				using m_const_iterator	= typename oi_multi::m_const_iterator;
+
+				using allocator_type	= typename oi_multi::allocator_type;
+
+				// Constructors:
+
+				using oi_base<Key, Value, Allocator, Map>::oi_base;
+				using oi_base<Key, Value, Allocator, Map>::operator=;
+				oi_multi& operator=(std::initializer_list<value_type> il) {
+					insert(il);
+					return *this;
+				}
+
+				// Modifiers:
+
+				iterator insert(const value_type& val) {
+					this->_list.emplace_back(this->_seq++, val);
+					iterator it_list = --this->_list.end();
+					this->_index_insert(it_list);
+					return it_list;
+				}
+				template<typename P, typename = typename std::enable_if<std::is_constructible<value_type, P&&>::value>::type>
+				iterator insert(P&& val) {
+					this->_list.emplace_back(this->_seq++, std::forward<P>(val));
+					iterator it_list = --this->_list.end();
+					this->_index_insert(it_list);
+					return it_list;
+				}
+				iterator insert(const_iterator hint, const value_type& val) {
+					return insert(val);
+				}
+				template<typename P, typename = typename std::enable_if<std::is_constructible<value_type, P&&>::value>::type>
+				iterator insert(const_iterator hint, P&& val) {
+					return insert(std::forward<P>(val));
+				}
+				template<class InputIterator>
+				void insert(InputIterator left, InputIterator right) {
+					for(; left != right; ++left)
+						insert(*left);
+				}
+				void insert(std::initializer_list<value_type> init_list) {
+					insert(init_list.begin(), init_list.end());
+				}
+
+				iterator erase(const_iterator pos) {
+					this->_index_erase(pos);
+					return this->_list.erase(pos);
+				}
+				size_type erase(const key_type& key) {
+					typename _map_t::iterator it_map = this->_map.find(key);
+					if(it_map == this->_map.end())
+						return 0;
+					size_type count = it_map->second.size();
+					for(const iterator& it : it_map->second)
+						this->_list.erase(it);
+					this->_map.erase(it_map);
+					return count;
+				}
+				iterator erase(const_iterator left, const_iterator right) {
+					iterator it;
+					while(left != right)
+						it = erase(left++);
+					return it;
+				}
+
+				template<class... Args>
+				iterator emplace(Args&&... args) {
+					return insert(std::pair<Args...>(std::forward<Args>(args)...));
+				}
+				template<class... Args>
+				iterator emplace_hint(const_iterator hint, Args&&... args) {
+					return insert(std::pair<Args...>(std::forward<Args>(args)...));
+				}
+
+				// Operations:
+
+				std::pair<m_iterator, m_iterator> equal_range(const key_type& key) {
+					std::pair<typename _map_t::iterator, typename _map_t::iterator> ret = this->_map.equal_range(key);
+					return std::pair<m_iterator, m_iterator>(ret.first, ret.second);
+				}
+				std::pair<m_const_iterator, m_const_iterator> equal_range(const key_type& key) const {
+					std::pair<typename _map_t::const_iterator, typename _map_t::const_iterator> ret = this->_map.equal_range(key);
+					return std::pair<m_const_iterator, m_const_iterator>(ret.first, ret.second);
+				}
+
+		};
+
+		template<class OiBase>
+		class oi_ordered : public OiBase {
+
+			protected:
+
+				using _map_t					= typename oi_ordered::_map_t;
+
+			public:
+
+				// Member Types:
+
+				using value_type				= typename oi_ordered::value_type;
+
+				using iterator					= typename oi_ordered::iterator;
+				using const_iterator			= typename oi_ordered::const_iterator;
+				using reverse_iterator			= std::reverse_iterator<iterator>;
+				using const_reverse_iterator	= std::reverse_iterator<const_iterator>;
+
+				using allocator_type			= typename oi_ordered::allocator_type;
+
+				using key_compare				= typename _map_t::key_compare;
+				using value_compare				= typename _map_t::value_compare;
+
+				using insertion_range			= seq_range<iterator, iterator>;
+				using const_insertion_range		= seq_range<const_iterator, iterator>;
+
+				// Constructors:
+
+				using OiBase::OiBase;
+				oi_ordered() {}
+				explicit oi_ordered(const key_compare& comp, const allocator_type& alloc = allocator_type()) : OiBase(alloc, comp) {}
+				template<class InputIterator>
+				oi_ordered(InputIterator left, InputIterator right, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) :oi_ordered(comp, alloc) {
+					this->insert(left, right);
+				}
+				template<class InputIterator>
+				oi_ordered(InputIterator left, InputIterator right, const allocator_type& alloc) : oi_ordered(left, right, key_compare(), alloc) {}
+				oi_ordered(std::initializer_list<value_type> il, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) : oi_ordered(comp, alloc) {
+					this->insert(il);
+				}
+				oi_ordered(std::initializer_list<value_type> il, const allocator_type& alloc) : oi_ordered(il, key_compare(), alloc) {}
+
+				// Iterators:
+
+				reverse_iterator rbegin() noexcept {
+					return this->_list.rbegin();
+				}
+				const_reverse_iterator rbegin() const noexcept {
+					return this->_list.rbegin();
+				}
+				const_reverse_iterator crbegin() const noexcept {
+					return this->_list.crbegin();
+				}
+				reverse_iterator rend() noexcept {
+					return this->_list.rend();
+				}
+				const_reverse_iterator rend() const noexcept {
+					return this->_list.rend();
+				}
+				const_reverse_iterator crend() const noexcept {
+					return this->_list.crend();
+				}
+
+				// Operations:
+
+				insertion_range range_in_insertion_order(const typename oi_ordered::key_type& left, const typename oi_ordered::key_type& right) { // keys in [left, right) by seq(), which is the iteration order unless splice() changed it
+					insertion_range ret;
+					_fill_range(ret, left, right);
+					return ret;
+				}
+				const_insertion_range range_in_insertion_order(const typename oi_ordered::key_type& left, const typename oi_ordered::key_type& right) const {
+					const_insertion_range ret;
+					_fill_range(ret, left, right);
+					return ret;
+				}
+
+				// Observers:
+
+				key_compare key_comp() const {
+					return key_compare();
+				}
+				value_compare value_comp() const {
+					return value_compare(key_comp());
+				}
+
+			private:
+
+				template<class Range>
+				void _fill_range(Range& range, const typename oi_ordered::key_type& left, const typename oi_ordered::key_type& right) const { // O(k) to build, each step then costs O(log k) over the k keys in range
+					if(!this->_map.key_comp()(left, right))
+						return;
+					for(typename _map_t::const_iterator it = this->_map.lower_bound(left), last = this->_map.lower_bound(right); it != last; ++it) {
+						std::pair<const iterator*, const iterator*> span = this->_index_span(it->second);
+						range.push(span.first, span.second);
+					}
+					range.seal();
+				}
+
+		};
+
+		template<class OiBase>
+		class oi_unordered : public OiBase {
+
+			protected:
+
+				using _map_t				= typename oi_unordered::_map_t;
+				using _list_t				= typename oi_unordered::_list_t;
+				using _grouped				= typename oi_unordered::_grouped;
+
+			public:
+
+				// Member Types:
+
+				using key_type				= typename oi_unordered::key_type;
+				using value_type			= typename oi_unordered::value_type;
+				using size_type				= typename oi_unordered::size_type;
+
+				using allocator_type		= typename oi_unordered::allocator_type;
+
+				using hasher				= typename _map_t::hasher;
+				using key_equal				= typename _map_t::key_equal;
+
+				using local_iterator		= typename oi_unordered::_index_t::template local_iterator<_map_t>;
+				using const_local_iterator	= typename oi_unordered::_index_t::template const_local_iterator<_map_t>;
+
+				// Constructors:
+
+				using OiBase::OiBase;
+				oi_unordered() {}
+				explicit oi_unordered(size_type n, const hasher& hf = hasher(), const key_equal& eql = key_equal(), const allocator_type& alloc = allocator_type()) : OiBase(alloc, n, hf, eql) {}
+				explicit oi_unordered(const allocator_type& alloc) : OiBase(alloc) {}
+				oi_unordered(size_type n, const allocator_type& alloc) : oi_unordered(n, hasher(), key_equal(), alloc) {}
+				oi_unordered(size_type n, const hasher& hf, const allocator_type& alloc) : oi_unordered(n, hf, key_equal(), alloc) {}
+				template<class InputIterator>
+				oi_unordered(InputIterator left, InputIterator right) {
+					this->insert(left, right);
+				}
+				template<class InputIterator>
+				oi_unordered(InputIterator left, InputIterator right, size_type n, const hasher& hf = hasher(), const key_equal& eql = key_equal(), const allocator_type& alloc = allocator_type()) : oi_unordered(n, hf, eql, alloc) {
+					this->insert(left, right);
+				}
+				template <class InputIterator>
+				oi_unordered(InputIterator left, InputIterator right, size_type n, const allocator_type& alloc) : oi_unordered(left, right, n, hasher(), key_equal(), alloc()) {}
+				template <class InputIterator>
+				oi_unordered(InputIterator left, InputIterator right, size_type n, const hasher& hf, const allocator_type& alloc) : oi_unordered(left, right, n, hf, key_equal(), alloc) {}
+				oi_unordered(std::initializer_list<value_type> il) {
+					this->insert(il);
+				}
+				oi_unordered(std::initializer_list<value_type> il, size_type n, const hasher& hf = hasher(), const key_equal& eql = key_equal(), const allocator_type& alloc = allocator_type()) : oi_unordered(n, hf, eql, alloc) {
+					this->insert(il);
+				}
+				oi_unordered(std::initializer_list<value_type> il, size_type n, const allocator_type& alloc) : oi_unordered(il, n, hasher(), key_equal(), alloc) {}
+				oi_unordered(std::initializer_list<value_type> il, size_type n, const hasher& hf, const allocator_type& alloc) : oi_unordered(il, n, hf, key_equal(), alloc) {}
+
+				// Iterators:
+
+				using OiBase::begin;
+				using OiBase::cbegin;
+				using OiBase::end;
+				using OiBase::cend;
+
+				local_iterator begin(size_type n) {
+					return this->_map.begin(n);
+				}
+				const_local_iterator begin(size_type n) const {
+					return this->_map.begin(n);
+				}
+				const_local_iterator cbegin(size_type n) const {
+					return this->_map.cbegin(n);
+				}
+				local_iterator end(size_type n) {
+					return this->_map.end(n);
+				}
+				const_local_iterator end(size_type n) const {
+					return this->_map.end(n);
+				}
+				const_local_iterator cend(size_type n) const {
+					return this->_map.cend(n);
+				}
+
+				// Buckets:
+
+				size_type bucket_count() const noexcept {
+					return this->_map.bucket_count();
+				}
+				size_type max_bucket_count() const noexcept {
+					return this->_map.max_bucket_count();
+				}
+				size_type bucket_size(size_type n) const { // elements walked by begin(n)..end(n), every duplicate included
+					return _bucket_size(n, _grouped());
+				}
+				size_type bucket(const key_type& key) const {
+					return this->_map.bucket(key);
+				}
+
+				// Hash Policy:
+
+				float load_factor() const noexcept { // size() / bucket_count(), while max_load_factor() bounds the distinct keys per bucket
+					return bucket_count() ? static_cast<float>(this->size()) / bucket_count() : 0.f;
+				}
+				float max_load_factor() const noexcept {
+					return this->_map.max_load_factor();
+				}
+				void max_load_factor(float f) {
+					this->_map.max_load_factor(f);
+				}
+				void rehash(size_type n) {
+					this->_map.rehash(n);
+				}
+				void reserve(size_type n) {
+					this->_map.reserve(n);
+				}
+
+				// Observers:
+
+				hasher hash_function() const {
+					return hasher();
+				}
+				key_equal key_eq() const {
+					return key_equal();
+				}
+
+			private:
+
+				size_type _bucket_size(size_type n, std::false_type) const {
+					return this->_map.bucket_size(n);
+				}
+				size_type _bucket_size(size_type n, std::true_type) const {
+					size_type count = 0;
+					for(typename _map_t::const_local_iterator it = this->_map.begin(n); it != this->_map.end(n); ++it)
+						count += it->second.size();
+					return count;
+				}
+
+		};
+
+		template<class ValType>
+		struct incremental_node {
+
+			template<class... Args>
+			incremental_node(std::size_t code, Args&&... args) : value(std::forward<Args>(args)...), hash(code), bucket_next(nullptr), prev(nullptr), next(nullptr) {}
+
+			ValType				value;
+			std::size_t			hash;
+			incremental_node*	bucket_next;	// chain of its bucket, relinked while the table migrates
+			incremental_node*	prev;			// every node is also kept in a list that iterators walk, so migrating never invalidates them
+			incremental_node*	next;
+
+		};
+
+		template<class ValType, class Ref>
+		class incremental_iter {
+
+			private:
+
+				using node_t = incremental_node<typename std::remove_const<ValType>::type>;
+
+			public:
+
+				using iterator_category = std::forward_iterator_tag;
+				using value_type		= typename std::remove_const<ValType>::type;
+				using difference_type	= std::ptrdiff_t;
+				using pointer			= Ref*;
+				using reference			= Ref&;
+
+				incremental_iter() : _node(nullptr) {}
+				explicit incremental_iter(node_t* node) : _node(node) {}
+				template<class OtherRef, class = typename std::enable_if<std::is_convertible<OtherRef*, Ref*>::value>::type>
+				incremental_iter(const incremental_iter<ValType, OtherRef>& other) : _node(other._node) {}
+
+				friend bool operator==(const incremental_iter& left, const incremental_iter& right) {
+					return left._node == right._node;
+				}
+				friend bool operator!=(const incremental_iter& left, const incremental_iter& right) {
+					return left._node != right._node;
+				}
+
+				incremental_iter& operator++() {
+					_node = _node->next;
+					return *this;
+				}
+				incremental_iter operator++(int) {
+					incremental_iter tmp(*this);
+					_node = _node->next;
+					return tmp;
+				}
+
+				reference operator*() const {
+					return _node->value;
+				}
+				pointer operator->() const {
+					return &_node->value;
+				}
+
+			private:
+
+				node_t* _node;
+
+				template<class, class> friend class incremental_iter;
+				template<class, class, class, class> friend class incremental_table;
+
+		};
+
+		template<class Key, class T, class Hash = std::hash<Key>, class Pred = std::equal_to<Key>>
+		class incremental_table { // unique key hash table that spreads each rehash over the following operations, like the Redis dict
+
+			private:
+
+				using node_t = incremental_node<std::pair<const Key, T>>;
+
+				struct bucket_deleter {
+					void operator()(node_t** buckets) const {
+						std::free(buckets);
+					}
+				};
+
+				struct table_t {
+					std::unique_ptr<node_t*[], bucket_deleter>	buckets; // calloc'd, large ones come as untouched zero pages instead of being cleared in one go
+					std::size_t									count = 0; // power of 2, or 0 if unallocated
+				};
+
+			public:
+
+				using key_type				= Key;
+				using mapped_type			= T;
+				using value_type			= std::pair<const Key, T>;
+				using size_type				= std::size_t;
+				using difference_type		= std::ptrdiff_t;
+				using hasher				= Hash;
+				using key_equal				= Pred;
+
+				using iterator				= incremental_iter<value_type, value_type>;
+				using const_iterator		= incremental_iter<value_type, const value_type>;
+
+				incremental_table() {}
+				explicit incremental_table(size_type n, const hasher& hf = hasher(), const key_equal& eql = key_equal()) : _hash(hf), _equal(eql) {
+					reserve(n);
+				}
+				incremental_table(const incremental_table& other) : _hash(other._hash), _equal(other._equal), _max_load(other._max_load) {
+					reserve(other.size());
+					for(const_iterator it = other.begin(); it != other.end(); ++it)
+						emplace(*it);
+				}
+				incremental_table(incremental_table&& other) noexcept {
+					swap(other);
+				}
+				~incremental_table() {
+					clear();
+				}
+
+				incremental_table& operator=(incremental_table other) noexcept {
+					swap(other);
+					return *this;
+				}
+
+				// Iterators:
+
+				iterator begin() noexcept {
+					return iterator(_head);
+				}
+				const_iterator begin() const noexcept {
+					return const_iterator(_head);
+				}
+				const_iterator cbegin() const noexcept {
+					return const_iterator(_head);
+				}
+				iterator end() noexcept {
+					return iterator();
+				}
+				const_iterator end() const noexcept {
+					return const_iterator();
+				}
+				const_iterator cend() const noexcept {
+					return const_iterator();
+				}
+
+				// Capacity:
+
+				bool empty() const noexcept {
+					return _size == 0;
+				}
+				size_type size() const noexcept {
+					return _size;
+				}
+				size_type max_size() const noexcept {
+					return std::numeric_limits<size_type>::max() / sizeof(node_t);
+				}
+
+				// Modifiers:
+
+				template<class... Args>
+				std::pair<iterator, bool> emplace(Args&&... args) {
+					_step();
+					std::unique_ptr<node_t> node(new node_t(0, std::forward<Args>(args)...));
+					node->hash = _hash(node->value.first);
+					node_t* found = _find(node->value.first, node->hash);
+					if(found)
+						return std::pair<iterator, bool>(iterator(found), false);
+					_grow(_size + 1);
+					_link(node.get());
+					return std::pair<iterator, bool>(iterator(node.release()), true);
+				}
+				template<class... Args>
+				iterator emplace_hint(const_iterator, Args&&... args) {
+					return emplace(std::forward<Args>(args)...).first;
+				}
+
+				iterator erase(const_iterator pos) {
+					_step();
+					node_t* node = pos._node;
+					node_t* next = node->next;
+					_unlink(node);
+					delete node;
+					return iterator(next);
+				}
+				size_type erase(const key_type& key) {
+					iterator it = find(key);
+					if(it == end())
+						return 0;
+					erase(it);
+					return 1;
+				}
+
+				void clear() noexcept {
+					while(_head) {
+						node_t* next = _head->next;
+						delete _head;
+						_head = next;
+					}
+					_tail = nullptr;
+					_size = 0;
+					if(rehashing()) {
+						std::swap(_tables[0], _tables[1]);
+						_tables[1] = table_t();
+						_rehash_pos = npos;
+					}
+					if(_tables[0].count)
+						std::fill(_tables[0].buckets.get(), _tables[0].buckets.get() + _tables[0].count, nullptr);
+				}
+
+				void swap(incremental_table& other) noexcept {
+					std::swap(_tables, other._tables);
+					std::swap(_rehash_pos, other._rehash_pos);
+					std::swap(_head, other._head);
+					std::swap(_tail, other._tail);
+					std::swap(_size, other._size);
+					std::swap(_max_load, other._max_load);
+					std::swap(_hash, other._hash);
+					std::swap(_equal, other._equal);
+				}
+
+				// Lookup:
+
+				iterator find(const key_type& key) {
+					_step();
+					return iterator(_find(key, _hash(key)));
+				}
+				const_iterator find(const key_type& key) const {
+					return const_iterator(_find(key, _hash(key)));
+				}
+
+				size_type count(const key_type& key) const {
+					return _find(key, _hash(key)) ? 1 : 0;
+				}
+
+				mapped_type& at(const key_type& key) {
+					iterator it = find(key);
+					if(it == end())
+						throw std::out_of_range("incremental_table::at");
+					return it->second;
+				}
+				const mapped_type& at(const key_type& key) const {
+					const_iterator it = find(key);
+					if(it == end())
+						throw std::out_of_range("incremental_table::at");
+					return it->second;
+				}
+
+				std::pair<iterator, iterator> equal_range(const key_type& key) {
+					iterator it = find(key);
+					return std::pair<iterator, iterator>(it, it == end() ? it : std::next(it));
+				}
+				std::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+					const_iterator it = find(key);
+					return std::pair<const_iterator, const_iterator>(it, it == end() ? it : std::next(it));
+				}
+
+				// Hash Policy:
+
+				size_type bucket_count() const noexcept {
+					return rehashing() ? _tables[1].count : _tables[0].count;
+				}
+				size_type max_bucket_count() const noexcept {
+					return max_size();
+				}
+				float load_factor() const noexcept {
+					return bucket_count() ? static_cast<float>(_size) / bucket_count() : 0.f;
+				}
+				float max_load_factor() const noexcept {
+					return _max_load;
+				}
+				void max_load_factor(float f) {
+					_max_load = f;
+					_grow(_size);
+				}
+				void rehash(size_type n) { // only starts a migration, the buckets are moved by the following operations
+					if(!rehashing() && n > _tables[0].count)
+						_start(n);
+				}
+				void reserve(size_type n) {
+					rehash(static_cast<size_type>(std::ceil(n / _max_load)));
+				}
+
+				bool rehashing() const noexcept {
+					return _rehash_pos != npos;
+				}
+
+				// Observers:
+
+				hasher hash_function() const {
+					return _hash;
+				}
+				key_equal key_eq() const {
+					return _equal;
+				}
+
+			private:
+
+				static constexpr size_type npos				= static_cast<size_type>(-1);
+				static constexpr size_type empty_visits		= 10; // empty buckets skipped per step at most, bounds the work of a single step
+
+				table_t		_tables[2];		// _tables[1] is only allocated while migrating from _tables[0]
+				size_type	_rehash_pos		= npos;
+				node_t*		_head			= nullptr;
+				node_t*		_tail			= nullptr;
+				size_type	_size			= 0;
+				float		_max_load		= 1.f;
+				hasher		_hash;
+				key_equal	_equal;
+
+				node_t* _find(const key_type& key, std::size_t hash) const {
+					for(std::size_t t = 0; t < 2; ++t) {
+						const table_t& table = _tables[t];
+						if(table.count == 0)
+							continue;
+						std::size_t b = hash & (table.count - 1);
+						if(t == 0 && rehashing() && b < _rehash_pos)
+							continue; // already migrated
+						for(node_t* node = table.buckets[b]; node; node = node->bucket_next) {
+							if(node->hash == hash && _equal(node->value.first, key))
+								return node;
+						}
+					}
+					return nullptr;
+				}
+
+				void _link(node_t* node) {
+					table_t& table = _tables[rehashing() ? 1 : 0];
+					node_t*& bucket = table.buckets[node->hash & (table.count - 1)];
+					node->bucket_next = bucket;
+					bucket = node;
+					node->prev = _tail;
+					(_tail ? _tail->next : _head) = node;
+					_tail = node;
+					++_size;
+				}
+
+				static bool _unchain(table_t& table, node_t* node) {
+					if(table.count == 0)
+						return false;
+					for(node_t** link = &table.buckets[node->hash & (table.count - 1)]; *link; link = &(*link)->bucket_next) {
+						if(*link == node) {
+							*link = node->bucket_next;
+							return true;
+						}
+					}
+					return false;
+				}
+
+				void _unlink(node_t* node) {
+					if(!_unchain(_tables[0], node))
+						_unchain(_tables[1], node);
+					(node->prev ? node->prev->next : _head) = node->next;
+					(node->next ? node->next->prev : _tail) = node->prev;
+					--_size;
+				}
+
+				void _grow(size_type n) {
+					if(_tables[0].count == 0)
+						_start(8);
+					else if(!rehashing() && n > _tables[0].count * _max_load)
+						_start(_tables[0].count * 2);
+				}
+
+				void _start(size_type n) {
+					std::size_t count = 8;
+					while(count < n)
+						count <<= 1;
+					table_t& table = _tables[0].count == 0 || _size == 0 ? _tables[0] : _tables[1]; // nothing to migrate if it's empty
+					table.buckets.reset(static_cast<node_t**>(std::calloc(count, sizeof(node_t*))));
+					if(!table.buckets)
+						throw std::bad_alloc();
+					table.count = count;
+					if(&table == &_tables[1])
+						_rehash_pos = 0;
+				}
+
+				void _step() { // migrates one bucket of _tables[0]
+					if(!rehashing())
+						return;
+					table_t& from = _tables[0];
+					table_t& to = _tables[1];
+					for(size_type visits = 0; _rehash_pos < from.count && !from.buckets[_rehash_pos]; ++_rehash_pos) {
+						if(++visits == empty_visits)
+							return;
+					}
+					if(_rehash_pos < from.count) {
+						node_t* node = from.buckets[_rehash_pos];
+						from.buckets[_rehash_pos++] = nullptr;
+						while(node) {
+							node_t* next = node->bucket_next;
+							node_t*& bucket = to.buckets[node->hash & (to.count - 1)];
+							node->bucket_next = bucket;
+							bucket = node;
+							node = next;
+						}
+					}
+					if(_rehash_pos == from.count) {
+						std::swap(from, to);
+						to.buckets.reset();
+						to.count = 0;
+						_rehash_pos = npos;
+					}
+				}
+
+		};
+
+		template<class Key, class T, class Hash, class Pred>
+		incremental_table<Key, T, Hash, Pred> index_like(const incremental_table<Key, T, Hash, Pred>& other, std::size_t n) {
+			incremental_table<Key, T, Hash, Pred> map(0, other.hash_function(), other.key_eq());
+			map.max_load_factor(other.max_load_factor());
+			map.reserve(n);
+			return map;
+		}
+
+		template<class Key>
+		struct int_hash { // fibonacci hashing, the top bits of key * 2^64 / phi pick the slot so strided keys still spread
+			std::size_t operator()(Key key) const noexcept {
+				return static_cast<std::size_t>(static_cast<std::uint64_t>(key) * 0x9E3779B97F4A7C15ull);
+			}
+		};
+
+		template<class ValType, class Ref>
+		class int_slot_iter {
+
+			public:
+
+				using iterator_category = std::forward_iterator_tag;
+				using value_type		= ValType;
+				using difference_type	= std::ptrdiff_t;
+				using pointer			= Ref*;
+				using reference			= Ref&;
+
+				int_slot_iter() : _slot(nullptr), _dist(nullptr), _end(nullptr) {}
+				int_slot_iter(Ref* slot, const std::uint8_t* dist, const std::uint8_t* end) : _slot(slot), _dist(dist), _end(end) {
+					_skip();
+				}
+				template<class OtherRef, class = typename std::enable_if<std::is_convertible<OtherRef*, Ref*>::value>::type>
+				int_slot_iter(const int_slot_iter<ValType, OtherRef>& other) : _slot(other._slot), _dist(other._dist), _end(other._end) {}
+
+				friend bool operator==(const int_slot_iter& left, const int_slot_iter& right) {
+					return left._dist == right._dist;
+				}
+				friend bool operator!=(const int_slot_iter& left, const int_slot_iter& right) {
+					return left._dist != right._dist;
+				}
+
+				int_slot_iter& operator++() {
+					++_slot;
+					++_dist;
+					_skip();
+					return *this;
+				}
+				int_slot_iter operator++(int) {
+					int_slot_iter tmp(*this);
+					++(*this);
+					return tmp;
+				}
+
+				reference operator*() const {
+					return *_slot;
+				}
+				pointer operator->() const {
+					return _slot;
+				}
+
+			private:
+
+				Ref*				_slot;
+				const std::uint8_t*	_dist; // probe distance of the slot plus one, 0 if it's empty
+				const std::uint8_t*	_end;
+
+				void _skip() {
+					while(_dist != _end && *_dist == 0) {
+						++_slot;
+						++_dist;
+					}
+				}
+
+				template<class, class> friend class int_slot_iter;
+				template<class, class> friend class int_hash_table;
+
+		};
+
+		template<class Key, class T>
+		class int_hash_table { // robin hood open addressing for integral keys, slots hold the key and the list iterator without any node
+
+			public:
+
+				using key_type				= Key;
+				using mapped_type			= T;
+				using value_type			= std::pair<Key, T>;
+				using size_type				= std::size_t;
+				using difference_type		= std::ptrdiff_t;
+				using hasher				= int_hash<Key>;
+				using key_equal				= std::equal_to<Key>;
+
+				using iterator				= int_slot_iter<value_type, value_type>;
+				using const_iterator		= int_slot_iter<value_type, const value_type>;
+
+				int_hash_table() {}
+				explicit int_hash_table(size_type n, const hasher& = hasher(), const key_equal& = key_equal()) {
+					reserve(n);
+				}
+				int_hash_table(int_hash_table&& other) noexcept {
+					swap(other);
+				}
+				int_hash_table& operator=(int_hash_table&& other) noexcept {
+					int_hash_table tmp(std::move(other));
+					swap(tmp);
+					return *this;
+				}
+
+				// Iterators:
+
+				iterator begin() noexcept {
+					return iterator(_slots.get(), _dist.get(), _dist.get() + _capacity);
+				}
+				const_iterator begin() const noexcept {
+					return const_iterator(_slots.get(), _dist.get(), _dist.get() + _capacity);
+				}
+				const_iterator cbegin() const noexcept {
+					return begin();
+				}
+				iterator end() noexcept {
+					return iterator(_slots.get() + _capacity, _dist.get() + _capacity, _dist.get() + _capacity);
+				}
+				const_iterator end() const noexcept {
+					return const_iterator(_slots.get() + _capacity, _dist.get() + _capacity, _dist.get() + _capacity);
+				}
+				const_iterator cend() const noexcept {
+					return end();
+				}
+
+				// Capacity:
+
+				bool empty() const noexcept {
+					return _size == 0;
+				}
+				size_type size() const noexcept {
+					return _size;
+				}
+				size_type max_size() const noexcept {
+					return std::numeric_limits<size_type>::max() / (sizeof(value_type) + 1);
+				}
+
+				// Modifiers:
+
+				std::pair<iterator, bool> emplace(const key_type& key, const mapped_type& mapped) {
+					size_type pos = _find(key);
+					if(pos != npos)
+						return std::pair<iterator, bool>(_at(pos), false);
+					if(_size + 1 > _capacity * _max_load)
+						_rehash(_capacity ? _capacity * 2 : 8);
+					pos = _place(value_type(key, mapped));
+					++_size;
+					return std::pair<iterator, bool>(_at(pos != npos ? pos : _find(key)), true);
+				}
+				iterator emplace_hint(const_iterator, const key_type& key, const mapped_type& mapped) {
+					return emplace(key, mapped).first;
+				}
+
+				iterator erase(const_iterator pos) { // shifts the following run back instead of leaving a tombstone
+					size_type i = static_cast<size_type>(pos._dist - _dist.get());
+					size_type hole = i;
+					for(size_type next = (i + 1) & _mask; _dist[next] > 1; next = (next + 1) & _mask) {
+						_slots[hole] = std::move(_slots[next]);
+						_dist[hole] = _dist[next] - 1;
+						hole = next;
+					}
+					_dist[hole] = 0;
+					--_size;
+					return _at(i);
+				}
+				size_type erase(const key_type& key) {
+					size_type pos = _find(key);
+					if(pos == npos)
+						return 0;
+					erase(_at(pos));
+					return 1;
+				}
+
+				void clear() noexcept {
+					if(_capacity)
+						std::fill(_dist.get(), _dist.get() + _capacity, 0);
+					_size = 0;
+				}
+
+				void swap(int_hash_table& other) noexcept {
+					std::swap(_slots, other._slots);
+					std::swap(_dist, other._dist);
+					std::swap(_capacity, other._capacity);
+					std::swap(_mask, other._mask);
+					std::swap(_shift, other._shift);
+					std::swap(_size, other._size);
+					std::swap(_max_load, other._max_load);
+				}
+
+				// Lookup:
+
+				iterator find(const key_type& key) {
+					size_type pos = _find(key);
+					return pos != npos ? _at(pos) : end();
+				}
+				const_iterator find(const key_type& key) const {
+					size_type pos = _find(key);
+					return pos != npos ? const_iterator(_slots.get() + pos, _dist.get() + pos, _dist.get() + _capacity) : end();
+				}
+
+				size_type count(const key_type& key) const {
+					return _find(key) != npos ? 1 : 0;
+				}
+
+				mapped_type& at(const key_type& key) {
+					size_type pos = _find(key);
+					if(pos == npos)
+						throw std::out_of_range("int_hash_table::at");
+					return _slots[pos].second;
+				}
+				const mapped_type& at(const key_type& key) const {
+					size_type pos = _find(key);
+					if(pos == npos)
+						throw std::out_of_range("int_hash_table::at");
+					return _slots[pos].second;
+				}
+
+				std::pair<iterator, iterator> equal_range(const key_type& key) {
+					iterator it = find(key);
+					return std::pair<iterator, iterator>(it, it == end() ? it : std::next(it));
+				}
+				std::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+					const_iterator it = find(key);
+					return std::pair<const_iterator, const_iterator>(it, it == end() ? it : std::next(it));
+				}
+
+				// Hash Policy:
+
+				size_type bucket_count() const noexcept {
+					return _capacity;
+				}
+				size_type max_bucket_count() const noexcept {
+					return max_size();
+				}
+				float load_factor() const noexcept {
+					return _capacity ? static_cast<float>(_size) / _capacity : 0.f;
+				}
+				float max_load_factor() const noexcept {
+					return _max_load;
+				}
+				void max_load_factor(float f) {
+					_max_load = std::min(f, 0.95f); // an open table needs some empty slots to end the probes
+					reserve(_size);
+				}
+				void rehash(size_type n) {
+					size_type count = 8;
+					while(count < n || count * _max_load < _size)
+						count <<= 1;
+					if(count > _capacity)
+						_rehash(count);
+				}
+				void reserve(size_type n) {
+					rehash(static_cast<size_type>(std::ceil(n / _max_load)));
+				}
+
+				// Observers:
+
+				hasher hash_function() const {
+					return hasher();
+				}
+				key_equal key_eq() const {
+					return key_equal();
+				}
+
+			private:
+
+				static constexpr size_type		npos		= static_cast<size_type>(-1);
+				static constexpr std::uint8_t	max_dist	= 0xff; // probe distances are kept in a byte, the table grows before one overflows
+
+				std::unique_ptr<value_type[]>	_slots;
+				std::unique_ptr<std::uint8_t[]>	_dist;
+				size_type						_capacity	= 0; // power of 2
+				size_type						_mask		= 0;
+				unsigned						_shift		= 64;
+				size_type						_size		= 0;
+				float							_max_load	= 0.8f;
+
+				iterator _at(size_type pos) {
+					return iterator(_slots.get() + pos, _dist.get() + pos, _dist.get() + _capacity);
+				}
+				size_type _home(const key_type& key) const {
+					return static_cast<size_type>((static_cast<std::uint64_t>(key) * 0x9E3779B97F4A7C15ull) >> _shift);
+				}
+
+				size_type _find(const key_type& key) const { // an element is never farther from its home than the ones it passed by
+					if(_size == 0)
+						return npos;
+					size_type i = _home(key);
+					for(unsigned dist = 1; _dist[i] >= dist; ++dist, i = (i + 1) & _mask) {
+						if(_dist[i] == dist && _slots[i].first == key)
+							return i;
+					}
+					return npos;
+				}
+
+				size_type _place(value_type val) { // returns where val ended up, or npos if the table had to grow meanwhile
+					size_type i = _home(val.first);
+					size_type placed = npos;
+					std::uint8_t dist = 1;
+					while(_dist[i] != 0) {
+						if(_dist[i] < dist) { // the richer element gives its slot away
+							std::swap(val, _slots[i]);
+							std::swap(dist, _dist[i]);
+							if(placed == npos)
+								placed = i;
+						}
+						i = (i + 1) & _mask;
+						if(++dist == max_dist) {
+							_rehash(_capacity * 2);
+							_place(std::move(val));
+							return npos;
+						}
+					}
+					_slots[i] = std::move(val);
+					_dist[i] = dist;
+					return placed != npos ? placed : i;
+				}
+
+				void _rehash(size_type count) {
+					std::unique_ptr<value_type[]> slots(std::move(_slots));
+					std::unique_ptr<std::uint8_t[]> dist(std::move(_dist));
+					size_type old = _capacity;
+					_slots.reset(new value_type[count]);
+					_dist.reset(new std::uint8_t[count]());
+					_capacity = count;
+					_mask = count - 1;
+					_shift = 64;
+					for(size_type n = count; n > 1; n >>= 1)
+						--_shift;
+					for(size_type i = 0; i < old; ++i) {
+						if(dist[i])
+							_place(std::move(slots[i]));
+					}
+				}
+
+		};
+
+		template<class Key, class T>
+		int_hash_table<Key, T> index_like(const int_hash_table<Key, T>& other, std::size_t n) {
+			int_hash_table<Key, T> map;
+			map.max_load_factor(other.max_load_factor());
+			map.reserve(n);
+			return map;
+		}
+
+		template<class Index, class Ref>
+		class int_block_iter {
+
+			public:
+
+				using iterator_category = std::bidirectional_iterator_tag;
+				using value_type		= typename Index::value_type;
+				using difference_type	= std::ptrdiff_t;
+				using pointer			= Ref*;
+				using reference			= Ref&;
+
+				int_block_iter() : _index(nullptr), _block(0), _slot(0) {}
+				int_block_iter(const Index* index, std::size_t block, std::size_t slot) : _index(index), _block(block), _slot(slot) {}
+				template<class OtherRef, class = typename std::enable_if<std::is_convertible<OtherRef*, Ref*>::value>::type>
+				int_block_iter(const int_block_iter<Index, OtherRef>& other) : _index(other._index), _block(other._block), _slot(other._slot) {}
+
+				friend bool operator==(const int_block_iter& left, const int_block_iter& right) {
+					return left._block == right._block && left._slot == right._slot;
+				}
+				friend bool operator!=(const int_block_iter& left, const int_block_iter& right) {
+					return !(left == right);
+				}
+
+				int_block_iter& operator++() {
+					if(++_slot == _index->_blocks[_block]->count) {
+						++_block;
+						_slot = 0;
+					}
+					return *this;
+				}
+				int_block_iter operator++(int) {
+					int_block_iter tmp(*this);
+					++(*this);
+					return tmp;
+				}
+				int_block_iter& operator--() {
+					if(_slot == 0)
+						_slot = _index->_blocks[--_block]->count;
+					--_slot;
+					return *this;
+				}
+				int_block_iter operator--(int) {
+					int_block_iter tmp(*this);
+					--(*this);
+					return tmp;
+				}
+
+				reference operator*() const {
+					return _index->_blocks[_block]->items[_slot];
+				}
+				pointer operator->() const {
+					return &_index->_blocks[_block]->items[_slot];
+				}
+
+			private:
+
+				const Index*	_index;
+				std::size_t		_block;
+				std::size_t		_slot; // always 0 at the end
+
+				template<class, class> friend class int_block_iter;
+				template<class, class> friend class int_block_index;
+
+		};
+
+		template<class Key, class T>
+		class int_block_index { // ordered index for integral keys: sorted blocks of contiguous entries, found through an array with the first key of each one
+
+			private:
+
+				static constexpr std::size_t block_size = 128;
+
+				struct block_t {
+					std::size_t						count = 0;
+					std::pair<Key, T>				items[block_size];
+				};
+
+			public:
+
+				using key_type					= Key;
+				using mapped_type				= T;
+				using value_type				= std::pair<Key, T>;
+				using size_type					= std::size_t;
+				using difference_type			= std::ptrdiff_t;
+				using key_compare				= std::less<Key>;
+
+				class value_compare {
+					public:
+						bool operator()(const value_type& left, const value_type& right) const {
+							return _comp(left.first, right.first);
+						}
+					protected:
+						value_compare(key_compare comp) : _comp(comp) {}
+						key_compare _comp;
+						friend class int_block_index;
+				};
+
+				using iterator					= int_block_iter<int_block_index, value_type>;
+				using const_iterator			= int_block_iter<int_block_index, const value_type>;
+				using reverse_iterator			= std::reverse_iterator<iterator>;
+				using const_reverse_iterator	= std::reverse_iterator<const_iterator>;
+
+				int_block_index() {}
+				explicit int_block_index(const key_compare&) {}
+				int_block_index(int_block_index&& other) noexcept {
+					swap(other);
+				}
+				int_block_index& operator=(int_block_index&& other) noexcept {
+					int_block_index tmp(std::move(other));
+					swap(tmp);
+					return *this;
+				}
+
+				// Iterators:
+
+				iterator begin() noexcept {
+					return iterator(this, 0, 0);
+				}
+				const_iterator begin() const noexcept {
+					return const_iterator(this, 0, 0);
+				}
+				const_iterator cbegin() const noexcept {
+					return begin();
+				}
+				iterator end() noexcept {
+					return iterator(this, _blocks.size(), 0);
+				}
+				const_iterator end() const noexcept {
+					return const_iterator(this, _blocks.size(), 0);
+				}
+				const_iterator cend() const noexcept {
+					return end();
+				}
+				reverse_iterator rbegin() noexcept {
+					return reverse_iterator(end());
+				}
+				const_reverse_iterator rbegin() const noexcept {
+					return const_reverse_iterator(end());
+				}
+				const_reverse_iterator crbegin() const noexcept {
+					return rbegin();
+				}
+				reverse_iterator rend() noexcept {
+					return reverse_iterator(begin());
+				}
+				const_reverse_iterator rend() const noexcept {
+					return const_reverse_iterator(begin());
+				}
+				const_reverse_iterator crend() const noexcept {
+					return rend();
+				}
+
+				// Capacity:
+
+				bool empty() const noexcept {
+					return _size == 0;
+				}
+				size_type size() const noexcept {
+					return _size;
+				}
+				size_type max_size() const noexcept {
+					return std::numeric_limits<size_type>::max() / sizeof(value_type);
+				}
+
+				// Modifiers:
+
+				std::pair<iterator, bool> emplace(const key_type& key, const mapped_type& mapped) {
+					if(_blocks.empty())
+						_add_block(0, key);
+					size_type b = _locate(key);
+					block_t* block = _blocks[b].get();
+					size_type s = _lower(block, key);
+					if(s < block->count && block->items[s].first == key)
+						return std::pair<iterator, bool>(iterator(this, b, s), false);
+					if(block->count == block_size) {
+						if(s == block_size && b + 1 == _blocks.size()) { // appending past a full last block starts a new one, so sorted insertions fill every block
+							block = _add_block(++b, key);
+							s = 0;
+						}
+						else {
+							_split(b);
+							if(s > block->count) {
+								s -= block->count;
+								block = _blocks[++b].get();
+							}
+						}
+					}
+					std::move_backward(block->items + s, block->items + block->count, block->items + block->count + 1);
+					block->items[s] = value_type(key, mapped);
+					++block->count;
+					if(s == 0)
+						_firsts[b] = key;
+					++_size;
+					return std::pair<iterator, bool>(iterator(this, b, s), true);
+				}
+				iterator emplace_hint(const_iterator, const key_type& key, const mapped_type& mapped) {
+					return emplace(key, mapped).first;
+				}
+
+				iterator erase(const_iterator pos) {
+					size_type b = pos._block;
+					size_type s = pos._slot;
+					block_t* block = _blocks[b].get();
+					std::move(block->items + s + 1, block->items + block->count, block->items + s);
+					--block->count;
+					--_size;
+					if(block->count == 0) {
+						_remove_block(b);
+						return iterator(this, b, 0);
+					}
+					if(s == 0)
+						_firsts[b] = block->items[0].first;
+					if(block->count < block_size / 4) { // merges underfull neighbours to keep the memory per entry bounded
+						if(b + 1 < _blocks.size() && block->count + _blocks[b + 1]->count <= block_size)
+							_merge(b);
+						else if(b > 0 && _blocks[b - 1]->count + block->count <= block_size) {
+							s += _blocks[b - 1]->count;
+							_merge(--b);
+						}
+					}
+					return _normalized(b, s);
+				}
+				iterator erase(iterator pos) {
+					return erase(const_iterator(pos));
+				}
+				size_type erase(const key_type& key) {
+					const_iterator it = find(key);
+					if(it == end())
+						return 0;
+					erase(it);
+					return 1;
+				}
+
+				void clear() noexcept {
+					_firsts.clear();
+					_blocks.clear();
+					_size = 0;
+				}
+
+				void swap(int_block_index& other) noexcept {
+					_firsts.swap(other._firsts);
+					_blocks.swap(other._blocks);
+					std::swap(_size, other._size);
+				}
+
+				// Lookup:
+
+				iterator find(const key_type& key) {
+					const_iterator it = static_cast<const int_block_index&>(*this).find(key);
+					return iterator(this, it._block, it._slot);
+				}
+				const_iterator find(const key_type& key) const {
+					if(_blocks.empty())
+						return end();
+					size_type b = _locate(key);
+					size_type s = _lower(_blocks[b].get(), key);
+					return s < _blocks[b]->count && _blocks[b]->items[s].first == key ? const_iterator(this, b, s) : end();
+				}
+
+				size_type count(const key_type& key) const {
+					return find(key) != end() ? 1 : 0;
+				}
+
+				mapped_type& at(const key_type& key) {
+					iterator it = find(key);
+					if(it == end())
+						throw std::out_of_range("int_block_index::at");
+					return it->second;
+				}
+				const mapped_type& at(const key_type& key) const {
+					const_iterator it = find(key);
+					if(it == end())
+						throw std::out_of_range("int_block_index::at");
+					return it->second;
+				}
+
+				iterator lower_bound(const key_type& key) {
+					if(_blocks.empty())
+						return end();
+					size_type b = _locate(key);
+					return _normalized(b, _lower(_blocks[b].get(), key));
+				}
+				const_iterator lower_bound(const key_type& key) const {
+					return const_cast<int_block_index*>(this)->lower_bound(key);
+				}
+				iterator upper_bound(const key_type& key) {
+					if(_blocks.empty())
+						return end();
+					size_type b = _locate(key);
+					block_t* block = _blocks[b].get();
+					return _normalized(b, static_cast<size_type>(std::upper_bound(block->items, block->items + block->count, key, [](const key_type& k, const value_type& item) { return k < item.first; }) - block->items));
+				}
+				const_iterator upper_bound(const key_type& key) const {
+					return const_cast<int_block_index*>(this)->upper_bound(key);
+				}
+
+				std::pair<iterator, iterator> equal_range(const key_type& key) {
+					iterator it = find(key);
+					return std::pair<iterator, iterator>(it, it == end() ? it : std::next(it));
+				}
+				std::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+					const_iterator it = find(key);
+					return std::pair<const_iterator, const_iterator>(it, it == end() ? it : std::next(it));
+				}
+
+				// Observers:
+
+				key_compare key_comp() const {
+					return key_compare();
+				}
+				value_compare value_comp() const {
+					return value_compare(key_compare());
+				}
+
+			private:
+
+				std::vector<Key>						_firsts; // first key of each block, the only array searched before reaching one
+				std::vector<std::unique_ptr<block_t>>	_blocks;
+				size_type								_size = 0;
+
+				size_type _locate(const key_type& key) const { // last block whose first key isn't greater than key, or the first one
+					size_type b = static_cast<size_type>(std::upper_bound(_firsts.begin(), _firsts.end(), key) - _firsts.begin());
+					return b ? b - 1 : 0;
+				}
+				static size_type _lower(const block_t* block, const key_type& key) {
+					return static_cast<size_type>(std::lower_bound(block->items, block->items + block->count, key, [](const value_type& item, const key_type& k) { return item.first < k; }) - block->items);
+				}
+				iterator _normalized(size_type b, size_type s) {
+					if(s == _blocks[b]->count) {
+						++b;
+						s = 0;
+					}
+					return iterator(this, b, s);
+				}
+
+				block_t* _add_block(size_type b, const key_type& first) {
+					std::unique_ptr<block_t> block(new block_t());
+					_firsts.insert(_firsts.begin() + b, first);
+					try {
+						_blocks.insert(_blocks.begin() + b, std::move(block));
+					}
+					catch(...) {
+						_firsts.erase(_firsts.begin() + b);
+						throw;
+					}
+					return _blocks[b].get();
+				}
+				void _remove_block(size_type b) {
+					_blocks.erase(_blocks.begin() + b);
+					_firsts.erase(_firsts.begin() + b);
+				}
+				void _split(size_type b) { // moves the upper half of a full block to a new one after it
+					block_t* block = _blocks[b].get();
+					block_t* upper = _add_block(b + 1, block->items[block_size / 2].first);
+					std::move(block->items + block_size / 2, block->items + block_size, upper->items);
+					upper->count = block_size - block_size / 2;
+					block->count = block_size / 2;
+				}
+				void _merge(size_type b) { // appends block b + 1 to block b
+					block_t* block = _blocks[b].get();
+					block_t* next = _blocks[b + 1].get();
+					std::move(next->items, next->items + next->count, block->items + block->count);
+					block->count += next->count;
+					_remove_block(b + 1);
+				}
+
+				template<class, class> friend class int_block_iter;
+
+		};
+
+		template<class Key, class Predicate, bool Grouped>
+		struct map_index_of {
+			template<class Node> using map = std::map<Key, typename index_mapped<Node, Grouped>::type, Predicate>;
+			static constexpr bool stable = true;
+		};
+		template<class Key, class Hash, class Predicate, bool Grouped>
+		struct unordered_index_of {
+			template<class Node> using map = std::unordered_map<Key, typename index_mapped<Node, Grouped>::type, Hash, Predicate>;
+			static constexpr bool stable = false; // a rehash may invalidate its iterators, so it's erased by key
+		};
+		template<class Key, class Hash, class Predicate>
+		struct incremental_index_of {
+			template<class Node> using map = incremental_table<Key, iter<Node>, Hash, Predicate>;
+			static constexpr bool stable = true;
+		};
+		template<class Key>
+		struct int_block_index_of {
+			template<class Node> using map = int_block_index<Key, iter<Node>>;
+			static constexpr bool stable = false;
+		};
+		template<class Key>
+		struct int_hash_index_of {
+			template<class Node> using map = int_hash_table<Key, iter<Node>>;
+			static constexpr bool stable = false;
+		};
+
+		template<class Key, class Value, class IndexOf, class... Indexes>
+		using index_map = typename with_indexes<typename IndexOf::template map<typename node_with<std::pair<const Key, Value>, IndexOf, Indexes...>::type>, Indexes...>::type;
+
+		template<std::size_t N>
+		struct small_slot {
+			using type = typename std::conditional<(N <= 0xff), unsigned char, typename std::conditional<(N <= 0xffff), unsigned short, std::size_t>::type>::type;
+		};
+
+		template<class Slot>
+		struct small_link {
+			Slot prev;
+			Slot next;
+		};
+
+		template<class ValType, class Slot, class BigIter> class small_m_iter;
+
+		template<class ValType, class Slot, class BigIter>
+		class small_iter { // follows the insertion order links of the inline storage while the map is small, and the spilled oi_map otherwise
+
+			public:
+
+				using iterator_category = std::bidirectional_iterator_tag;
+				using value_type		= typename std::remove_const<ValType>::type;
+				using difference_type	= std::ptrdiff_t;
+				using pointer			= ValType*;
+				using reference			= ValType&;
+
+				small_iter() : _links(nullptr), _base(nullptr), _slot(0) {}
+				small_iter(const small_link<Slot>* links, ValType* base, Slot slot) : _links(links), _base(base), _slot(slot) {}
+				small_iter(const BigIter& iter) : _links(nullptr), _base(nullptr), _slot(0), _big(iter) {}
+				template<class OtherVal, class OtherBig, class = typename std::enable_if<std::is_convertible<OtherVal*, ValType*>::value>::type>
+				small_iter(const small_iter<OtherVal, Slot, OtherBig>& other) : _links(other._links), _base(other._base), _slot(other._slot), _big(other._big) {}
+				template<class OtherVal, class OtherBig, class = typename std::enable_if<std::is_convertible<OtherVal*, ValType*>::value>::type>
+				small_iter(const small_m_iter<OtherVal, Slot, OtherBig>& other) : _links(other._links), _base(other._base), _slot(other._pos ? *other._pos : Slot()), _big(other._pos ? BigIter() : BigIter(other._big)) {}
+
+				friend bool operator==(const small_iter& left, const small_iter& right) {
+					return left._links == right._links && (left._links ? left._slot == right._slot : left._big == right._big);
+				}
+				friend bool operator!=(const small_iter& left, const small_iter& right) {
+					return !(left == right);
+				}
+
+				small_iter& operator++() {
+					if(_links)
+						_slot = _links[_slot].next;
+					else
+						++_big;
+					return *this;
+				}
+				small_iter operator++(int) {
+					small_iter tmp(*this);
+					++(*this);
+					return tmp;
+				}
+
+				small_iter& operator--() {
+					if(_links)
+						_slot = _links[_slot].prev;
+					else
+						--_big;
+					return *this;
+				}
+				small_iter operator--(int) {
+					small_iter tmp(*this);
+					--(*this);
+					return tmp;
+				}
+
+				reference operator*() const {
+					return _links ? _base[_slot] : *_big;
+				}
+				pointer operator->() const {
+					return &**this;
+				}
+
+			private:
+
+				const small_link<Slot>*	_links;
+				ValType*				_base;
+				Slot					_slot; // position in the inline storage, N past the last element
+				BigIter					_big;
+
+				template<class, class, class> friend class small_iter;
+				template<class, class, class> friend class small_m_iter;
+				template<class, class, std::size_t, class, class> friend class neo::oi_small_map;
+
+		};
+
+		template<class ValType, class Slot, class BigIter>
+		class small_m_iter { // walks the slots sorted by key while the map is small, and the spilled oi_map m_iterators otherwise
+
+			public:
+
+				using iterator_category = std::bidirectional_iterator_tag;
+				using value_type		= typename std::remove_const<ValType>::type;
+				using difference_type	= std::ptrdiff_t;
+				using pointer			= ValType*;
+				using reference			= ValType&;
+
+				small_m_iter() : _pos(nullptr), _base(nullptr), _links(nullptr) {}
+				small_m_iter(const Slot* pos, ValType* base, const small_link<Slot>* links) : _pos(pos), _base(base), _links(links) {}
+				small_m_iter(const BigIter& iter) : _pos(nullptr), _base(nullptr), _links(nullptr), _big(iter) {}
+				template<class OtherVal, class OtherBig, class = typename std::enable_if<std::is_convertible<OtherVal*, ValType*>::value>::type>
+				small_m_iter(const small_m_iter<OtherVal, Slot, OtherBig>& other) : _pos(other._pos), _base(other._base), _links(other._links), _big(other._big) {}
+
+				friend bool operator==(const small_m_iter& left, const small_m_iter& right) {
+					return left._pos == right._pos && (left._pos != nullptr || left._big == right._big);
+				}
+				friend bool operator!=(const small_m_iter& left, const small_m_iter& right) {
+					return !(left == right);
+				}
+
+				small_m_iter& operator++() {
+					if(_pos)
+						++_pos;
+					else
+						++_big;
+					return *this;
+				}
+				small_m_iter operator++(int) {
+					small_m_iter tmp(*this);
+					++(*this);
+					return tmp;
+				}
+
+				small_m_iter& operator--() {
+					if(_pos)
+						--_pos;
+					else
+						--_big;
+					return *this;
+				}
+				small_m_iter operator--(int) {
+					small_m_iter tmp(*this);
+					--(*this);
+					return tmp;
+				}
+
+				reference operator*() const {
+					return _pos ? _base[*_pos] : *_big;
+				}
+				pointer operator->() const {
+					return &**this;
+				}
+
+			private:
+
+				const Slot*				_pos;
+				ValType*				_base;
+				const small_link<Slot>*	_links; // to convert into a small_iter
+				BigIter					_big;
+
+				template<class, class, class> friend class small_iter;
+				template<class, class, class> friend class small_m_iter;
+
+		};
+
+		template<class OiMap, class T, class = void>
+		struct tracked_keys { // change records of oi_tracked by key, compared the same way the tracked map does
+			using type = std::map<typename OiMap::key_type, T, typename OiMap::key_compare>;
+			static type make(const OiMap& map) {
+				return type(map.key_comp());
+			}
+		};
+		template<class OiMap, class T>
+		struct tracked_keys<OiMap, T, typename std::conditional<true, void, typename OiMap::hasher>::type> {
+			using type = std::unordered_map<typename OiMap::key_type, T, typename OiMap::hasher, typename OiMap::key_equal>;
+			static type make(const OiMap& map) {
+				return type(0, map.hash_function(), map.key_eq());
+			}
+		};
+
+
+#ifdef __NEO_OI_MAP_CPP14__
+
+		constexpr std::size_t frozen_pow2(std::size_t n) {
+			std::size_t m = 1;
+			while(m < n)
+				m <<= 1;
+			return m;
+		}
+
+		template<class ValType>
+		class frozen_m_iter { // walks the key order precomputed by frozen_oi_map
+
+			public:
+
+				using iterator_category = std::bidirectional_iterator_tag;
+				using value_type		= ValType;
+				using difference_type	= std::ptrdiff_t;
+				using pointer			= const ValType*;
+				using reference			= const ValType&;
+
+				constexpr frozen_m_iter() : _pos(nullptr), _base(nullptr) {}
+				constexpr frozen_m_iter(const std::size_t* pos, const ValType* base) : _pos(pos), _base(base) {}
+
+				constexpr bool operator==(const frozen_m_iter& other) const {
+					return _pos == other._pos;
+				}
+				constexpr bool operator!=(const frozen_m_iter& other) const {
+					return !(*this == other);
+				}
+
+				constexpr frozen_m_iter& operator++() {
+					++_pos;
+					return *this;
+				}
+				constexpr frozen_m_iter operator++(int) {
+					frozen_m_iter tmp(*this);
+					++_pos;
+					return tmp;
+				}
+
+				constexpr frozen_m_iter& operator--() {
+					--_pos;
+					return *this;
+				}
+				constexpr frozen_m_iter operator--(int) {
+					frozen_m_iter tmp(*this);
+					--_pos;
+					return tmp;
+				}
+
+				constexpr reference operator*() const {
+					return _base[*_pos];
+				}
+				constexpr pointer operator->() const {
+					return _base + *_pos;
+				}
+
+				constexpr operator const ValType*() const {
+					return _base + *_pos;
+				}
+
+			private:
+
+				const std::size_t* _pos;
+				const ValType*	   _base;
+
+		};
+
+#endif
+
+	}
+
+	template<class Tag, class KeyFn, class Hash = __oi_map_details::index_hash, class Predicate = __oi_map_details::index_equal_to>
+	struct oi_hashed_index { // secondary index on KeyFn(mapped_type) with non unique keys, found by get<Tag>()
+		using tag = Tag;
+		template<class Node> using hook = __oi_map_details::hashed_hook<Node>;
+		template<class Node, std::size_t I> using index = __oi_map_details::hashed_index<Node, I, KeyFn, Hash, Predicate>;
+	};
+
+	template<class Tag, class KeyFn, class Compare = __oi_map_details::index_less>
+	struct oi_ordered_index {
+		using tag = Tag;
+		template<class Node> using hook = __oi_map_details::ordered_hook<Node>;
+		template<class Node, std::size_t I> using index = __oi_map_details::ordered_index<Node, I, KeyFn, Compare>;
+	};
+
+	template<class Key, class Value, class Predicate = std::less<Key>, class Allocator = std::allocator<std::pair<const Key, Value>>, class... Indexes>
+	class oi_map : public __oi_map_details::oi_ordered<__oi_map_details::oi_single<Key, Value, Allocator, __oi_map_details::index_map<Key, Value, __oi_map_details::map_index_of<Key, Predicate, false>, Indexes...>>> {
+		public:
+			using __oi_map_details::oi_ordered<__oi_map_details::oi_single<Key, Value, Allocator, __oi_map_details::index_map<Key, Value, __oi_map_details::map_index_of<Key, Predicate, false>, Indexes...>>>::oi_ordered;
+			typename oi_map::iterator lower_bound(const typename oi_map::key_type& key) {
+				return this->_map.lower_bound(key)->second;
+			}
+			typename oi_map::const_iterator lower_bound(const typename oi_map::key_type& key) const {
+				return this->_map.lower_bound(key)->second;
+			}
+			typename oi_map::iterator upper_bound(const typename oi_map::key_type& key) {
+				return this->_map.upper_bound(key)->second;
+			}
+			typename oi_map::const_iterator upper_bound(const typename oi_map::key_type& key) const {
+				return this->_map.upper_bound(key)->second;
+			}
+	};
+
+	template<class Key, class Value, class Predicate = std::less<Key>, class Allocator = std::allocator<std::pair<const Key, Value>>>
+	class oi_multimap : public __oi_map_details::oi_ordered<__oi_map_details::oi_multi<Key, Value, Allocator, __oi_map_details::index_map<Key, Value, __oi_map_details::map_index_of<Key, Predicate, true>>>> {
+		public:
+			using __oi_map_details::oi_ordered<__oi_map_details::oi_multi<Key, Value, Allocator, __oi_map_details::index_map<Key, Value, __oi_map_details::map_index_of<Key, Predicate, true>>>>::oi_ordered;
+			typename oi_multimap::m_iterator lower_bound(const typename oi_multimap::key_type& key) {
+				return this->_map.lower_bound(key);
+			}
+			typename oi_multimap::m_const_iterator lower_bound(const typename oi_multimap::key_type& key) const {
+				return this->_map.lower_bound(key);
+			}
+			typename oi_multimap::m_iterator upper_bound(const typename oi_multimap::key_type& key) {
+				return this->_map.upper_bound(key);
+			}
+			typename oi_multimap::m_const_iterator upper_bound(const typename oi_multimap::key_type& key) const {
+				return this->_map.upper_bound(key);
+			}
+	};
+
+	template<class Key, class Value, class Hash = std::hash<Key>, class Predicate = std::equal_to<Key>, class Allocator = std::allocator<std::pair<const Key, Value>>, class... Indexes>
+	class oi_unordered_map : public __oi_map_details::oi_unordered<__oi_map_details::oi_single<Key, Value, Allocator, __oi_map_details::index_map<Key, Value, __oi_map_details::unordered_index_of<Key, Hash, Predicate, false>, Indexes...>>> {
+		public:
+			using __oi_map_details::oi_unordered<__oi_map_details::oi_single<Key, Value, Allocator, __oi_map_details::index_map<Key, Value, __oi_map_details::unordered_index_of<Key, Hash, Predicate, false>, Indexes...>>>::oi_unordered;
+	};
+
+	template<class Key, class Value, class Hash = std::hash<Key>, class Predicate = std::equal_to<Key>, class Allocator = std::allocator<std::pair<const Key, Value>>>
+	class oi_unordered_multimap : public __oi_map_details::oi_unordered<__oi_map_details::oi_multi<Key, Value, Allocator, __oi_map_details::index_map<Key, Value, __oi_map_details::unordered_index_of<Key, Hash, Predicate, true>>>> {
+		public:
+			using __oi_map_details::oi_unordered<__oi_map_details::oi_multi<Key, Value, Allocator, __oi_map_details::index_map<Key, Value, __oi_map_details::unordered_index_of<Key, Hash, Predicate, true>>>>::oi_unordered;
+	};
+
+	template<class Key, class Value, class Hash = std::hash<Key>, class Predicate = std::equal_to<Key>, class Allocator = std::allocator<std::pair<const Key, Value>>>
+	class oi_incremental_unordered_map : public __oi_map_details::oi_unordered<__oi_map_details::oi_single<Key, Value, Allocator, __oi_map_details::index_map<Key, Value, __oi_map_details::incremental_index_of<Key, Hash, Predicate>>>> {
+		public:
+			using __oi_map_details::oi_unordered<__oi_map_details::oi_single<Key, Value, Allocator, __oi_map_details::index_map<Key, Value, __oi_map_details::incremental_index_of<Key, Hash, Predicate>>>>::oi_unordered;
+			bool rehashing() const noexcept {
+				return this->_map.rehashing();
+			}
+	};
+
+	template<class Key, class Value, class Allocator = std::allocator<std::pair<const Key, Value>>>
+	class oi_int_map : public __oi_map_details::oi_ordered<__oi_map_details::oi_single<Key, Value, Allocator, __oi_map_details::index_map<Key, Value, __oi_map_details::int_block_index_of<Key>>>> {
+		static_assert(std::is_integral<Key>::value, "oi_int_map requires an integral key");
+		public:
+			using __oi_map_details::oi_ordered<__oi_map_details::oi_single<Key, Value, Allocator, __oi_map_details::index_map<Key, Value, __oi_map_details::int_block_index_of<Key>>>>::oi_ordered;
+			typename oi_int_map::iterator lower_bound(const typename oi_int_map::key_type& key) {
+				typename oi_int_map::_map_t::iterator it = this->_map.lower_bound(key);
+				return it != this->_map.end() ? it->second : this->end();
+			}
+			typename oi_int_map::const_iterator lower_bound(const typename oi_int_map::key_type& key) const {
+				typename oi_int_map::_map_t::const_iterator it = this->_map.lower_bound(key);
+				return it != this->_map.end() ? it->second : this->end();
+			}
+			typename oi_int_map::iterator upper_bound(const typename oi_int_map::key_type& key) {
+				typename oi_int_map::_map_t::iterator it = this->_map.upper_bound(key);
+				return it != this->_map.end() ? it->second : this->end();
+			}
+			typename oi_int_map::const_iterator upper_bound(const typename oi_int_map::key_type& key) const {
+				typename oi_int_map::_map_t::const_iterator it = this->_map.upper_bound(key);
+				return it != this->_map.end() ? it->second : this->end();
+			}
+	};
+
+	template<class Key, class Value, class Allocator = std::allocator<std::pair<const Key, Value>>>
+	class oi_int_unordered_map : public __oi_map_details::oi_unordered<__oi_map_details::oi_single<Key, Value, Allocator, __oi_map_details::index_map<Key, Value, __oi_map_details::int_hash_index_of<Key>>>> {
+		static_assert(std::is_integral<Key>::value, "oi_int_unordered_map requires an integral key");
+		public:
+			using __oi_map_details::oi_unordered<__oi_map_details::oi_single<Key, Value, Allocator, __oi_map_details::index_map<Key, Value, __oi_map_details::int_hash_index_of<Key>>>>::oi_unordered;
+	};
+
+	template<class OiMap>
+	class oi_cow { // copy-on-write handle owned by a single writer thread, snapshot() is O(1) but nothing is shared between versions, the first write() after it copies the whole map in O(n)
+
+		public:
+
+			using map_type		= OiMap;
+			using snapshot_type	= std::shared_ptr<const OiMap>;
+
+			oi_cow() : _map(std::make_shared<OiMap>()) {}
+			explicit oi_cow(const OiMap& map) : _map(std::make_shared<OiMap>(map)) {}
+			explicit oi_cow(OiMap&& map) : _map(std::make_shared<OiMap>(std::forward<OiMap>(map))) {}
+
+			oi_cow(const oi_cow&) = delete; // two handles would write to the same map, snapshot() is the way to share it
+			oi_cow& operator=(const oi_cow&) = delete;
+			oi_cow(oi_cow&&) = default;
+			oi_cow& operator=(oi_cow&&) = default;
+
+			snapshot_type snapshot() { // writer thread only, the readers can keep and drop the returned map from any thread
+				_check_writer();
+				_shared = true;
+				return _map;
+			}
+
+			const OiMap& read() const noexcept {
+				return *_map;
+			}
+			const OiMap& operator*() const noexcept {
+				return *_map;
+			}
+			const OiMap* operator->() const noexcept {
+				return _map.get();
+			}
+
+			OiMap& write() { // writer thread only
+				_check_writer();
+				if(_shared) {
+					_map = std::make_shared<OiMap>(*_map);
+					_shared = false;
+				}
+				return *_map;
+			}
+
+		private:
+
+			std::shared_ptr<OiMap>	_map;
+			bool					_shared = false; // a snapshot may still point to *_map, the writer never asks the readers through use_count()
+			std::thread::id			_writer; // thread of the first snapshot() or write()
+
+			void _check_writer() {
+				if(_writer == std::thread::id())
+					_writer = std::this_thread::get_id();
+				assert(_writer == std::this_thread::get_id() && "oi_cow: snapshot() and write() must be called by the writer thread");
+			}
+
+	};
+	template<class OiMap>
+	class oi_bounded : public OiMap { // evicts the oldest elements in insertion order as soon as the size goes past capacity()
+
+		public:
+
+			// Member Types:
+
+			using key_type			= typename OiMap::key_type;
+			using mapped_type		= typename OiMap::mapped_type;
+			using value_type		= typename OiMap::value_type;
+			using size_type			= typename OiMap::size_type;
+			using seq_type			= typename OiMap::seq_type;
+
+			using iterator			= typename OiMap::iterator;
+			using const_iterator	= typename OiMap::const_iterator;
+
+			using evict_callback	= std::function<void(value_type&)>;
+
+			// Constructors:
+
+			using OiMap::OiMap;
+			oi_bounded() {}
+			explicit oi_bounded(size_type capacity, evict_callback on_evict = evict_callback()) : _capacity(capacity), _on_evict(std::move(on_evict)) {}
+
+			// Capacity:
+
+			size_type capacity() const noexcept {
+				return _capacity;
+			}
+			void capacity(size_type n) { // 0 means unbounded
+				_capacity = n;
+				_evict();
+			}
+
+			void on_evict(evict_callback fn) {
+				_on_evict = std::move(fn);
+			}
+
+			// Element Access:
+
+			typename OiMap::_mapped_ref operator[](const key_type& key) {
+				typename OiMap::_mapped_ref ret = OiMap::operator[](key);
+				_evict();
+				return ret;
+			}
+			typename OiMap::_mapped_ref operator[](key_type&& key) {
+				typename OiMap::_mapped_ref ret = OiMap::operator[](std::forward<key_type>(key));
+				_evict();
+				return ret;
+			}
+
+			// Modifiers:
+
+			auto insert(const value_type& val) -> decltype(std::declval<OiMap&>().insert(val)) {
+				auto ret = OiMap::insert(val);
+				_evict();
+				return ret;
+			}
+			template<typename P, typename = typename std::enable_if<std::is_constructible<value_type, P&&>::value>::type>
+			auto insert(P&& val) -> decltype(std::declval<OiMap&>().insert(std::forward<P>(val))) {
+				auto ret = OiMap::insert(std::forward<P>(val));
+				_evict();
+				return ret;
+			}
+			iterator insert(const_iterator hint, const value_type& val) {
+				iterator ret = OiMap::insert(hint, val);
+				_evict();
+				return ret;
+			}
+			template<typename P, typename = typename std::enable_if<std::is_constructible<value_type, P&&>::value>::type>
+			iterator insert(const_iterator hint, P&& val) {
+				iterator ret = OiMap::insert(hint, std::forward<P>(val));
+				_evict();
+				return ret;
+			}
+			template<class InputIterator>
+			void insert(InputIterator left, InputIterator right) {
+				for(; left != right; ++left)
+					insert(*left);
+			}
+			void insert(std::initializer_list<value_type> init_list) {
+				insert(init_list.begin(), init_list.end());
+			}
+
+			template<class... Args>
+			auto emplace(Args&&... args) -> decltype(std::declval<OiMap&>().emplace(std::forward<Args>(args)...)) {
+				auto ret = OiMap::emplace(std::forward<Args>(args)...);
+				_evict();
+				return ret;
+			}
+			template<class... Args>
+			iterator emplace_hint(const_iterator hint, Args&&... args) {
+				iterator ret = OiMap::emplace_hint(hint, std::forward<Args>(args)...);
+				_evict();
+				return ret;
+			}
+
+			using OiMap::trim_front;
+			using OiMap::trim_front_before;
+			void pop_front() {
+				trim_front(1);
+			}
+			size_type trim_front(size_type n) {
+				return _on_evict ? OiMap::trim_front(n, _on_evict) : OiMap::trim_front(n);
+			}
+			size_type trim_front_before(seq_type seq) {
+				return _on_evict ? OiMap::trim_front_before(seq, _on_evict) : OiMap::trim_front_before(seq);
+			}
+
+		private:
+
+			size_type		_capacity = 0;
+			evict_callback	_on_evict;
+
+			void _evict() {
+				if(_capacity != 0 && this->size() > _capacity)
+					trim_front(this->size() - _capacity);
+			}
+
+	};
+	template<class OiMap>
+	class oi_tracked : public OiMap { // records which keys changed at each epoch, changes_since() turns that into a delta that apply_delta() replays on a replica
+
+		public:
+
+			// Member Types:
+
+			using key_type			= typename OiMap::key_type;
+			using mapped_type		= typename OiMap::mapped_type;
+			using value_type		= typename OiMap::value_type;
+			using size_type			= typename OiMap::size_type;
+			using seq_type			= typename OiMap::seq_type;
+			using epoch_type		= std::uint64_t;
+
+			using iterator			= typename OiMap::iterator;
+			using const_iterator	= typename OiMap::const_iterator;
+
+			struct delta {
+				epoch_type										since = 0;
+				epoch_type										until = 0;
+				bool											reset = false; // the replica clears itself first, since was older than what the log remembers
+				std::vector<key_type>							erased;
+				std::vector<std::pair<key_type, mapped_type>>	values; // current contents of the changed elements and of the anchors of the moved ones
+				std::vector<std::pair<size_type, size_type>>	moves; // (element, anchor) indexes in values, the element goes right after its anchor, or to the front when it's its own anchor
+			};
+
+			static_assert(std::is_same<decltype(std::declval<OiMap&>().insert(std::declval<const value_type&>())), std::pair<iterator, bool>>::value, "oi_tracked requires a map with unique keys");
+
+			// Constructors:
+
+			using OiMap::OiMap;
+			oi_tracked() {}
+			oi_tracked(const oi_tracked& other) : OiMap(other), _epoch(other._epoch), _horizon(other._horizon) {
+				for(const _record& rec : other._log) {
+					typename _keys_t::iterator at = _keys.emplace(*rec.first, *rec.second).first;
+					_log.emplace_back(&at->first, &at->second);
+					at->second.pos = --_log.end();
+				}
+			}
+			oi_tracked(oi_tracked&&) = default;
+
+			oi_tracked& operator=(const oi_tracked& other) {
+				if(this != &other) {
+					oi_tracked tmp(other);
+					swap(tmp);
+				}
+				return *this;
+			}
+			oi_tracked& operator=(oi_tracked&&) = default;
+			oi_tracked& operator=(std::initializer_list<value_type> il) {
+				OiMap::operator=(il);
+				_reset();
+				return *this;
+			}
+
+			// Element Access:
+
+			typename OiMap::_mapped_ref operator[](const key_type& key) {
+				size_type n = this->size();
+				typename OiMap::_mapped_ref ret = OiMap::operator[](key);
+				_touch(key, this->size() != n);
+				return ret;
+			}
+			typename OiMap::_mapped_ref operator[](key_type&& key) {
+				size_type n = this->size();
+				iterator it = OiMap::insert(value_type(std::forward<key_type>(key), mapped_type())).first;
+				_touch(it->first, this->size() != n);
+				return it->second;
+			}
+
+			using OiMap::at;
+			typename OiMap::_mapped_ref at(const key_type& key) {
+				typename OiMap::_mapped_ref ret = OiMap::at(key);
+				_touch(key, false);
+				return ret;
+			}
+
+			// Modifiers:
+
+			std::pair<iterator, bool> insert(const value_type& val) {
+				std::pair<iterator, bool> ret = OiMap::insert(val);
+				if(ret.second)
+					_touch(ret.first->first, true);
+				return ret;
+			}
+			template<typename P, typename = typename std::enable_if<std::is_constructible<value_type, P&&>::value>::type>
+			std::pair<iterator, bool> insert(P&& val) {
+				std::pair<iterator, bool> ret = OiMap::insert(std::forward<P>(val));
+				if(ret.second)
+					_touch(ret.first->first, true);
+				return ret;
+			}
+			iterator insert(const_iterator, const value_type& val) {
+				return insert(val).first;
+			}
+			template<typename P, typename = typename std::enable_if<std::is_constructible<value_type, P&&>::value>::type>
+			iterator insert(const_iterator, P&& val) {
+				return insert(std::forward<P>(val)).first;
+			}
+			template<class InputIterator>
+			void insert(InputIterator left, InputIterator right) {
+				for(; left != right; ++left)
+					insert(*left);
+			}
+			void insert(std::initializer_list<value_type> init_list) {
+				insert(init_list.begin(), init_list.end());
+			}
+
+			template<class... Args>
+			std::pair<iterator, bool> emplace(Args&&... args) {
+				std::pair<iterator, bool> ret = OiMap::emplace(std::forward<Args>(args)...);
+				if(ret.second)
+					_touch(ret.first->first, true);
+				return ret;
+			}
+			template<class... Args>
+			iterator emplace_hint(const_iterator, Args&&... args) {
+				return emplace(std::forward<Args>(args)...).first;
+			}
+
+			iterator erase(const_iterator pos) {
+				_touch(pos->first, false);
+				return OiMap::erase(pos);
+			}
+			size_type erase(const key_type& key) {
+				const_iterator it = this->find(key);
+				if(it == this->cend())
+					return 0;
+				erase(it);
+				return 1;
+			}
+			iterator erase(const_iterator left, const_iterator right) {
+				iterator it = OiMap::end();
+				while(left != right)
+					it = erase(left++);
+				return it;
+			}
+
+			void clear() noexcept {
+				OiMap::clear();
+				_reset();
+			}
+			void swap(oi_tracked& other) {
+				OiMap::swap(other);
+				_keys.swap(other._keys);
+				_log.swap(other._log);
+				std::swap(_epoch, other._epoch);
+				std::swap(_horizon, other._horizon);
+			}
+
+			template<class Fn>
+			void modify(const_iterator pos, Fn&& fn) {
+				OiMap::modify(pos, std::forward<Fn>(fn));
+				_touch(pos->first, false);
+			}
+			void touch(const_iterator pos) { // for writes made through iterators or through references kept from before the last changes_since()
+				_touch(pos->first, false);
+			}
+
+			// Extra:
+
+			void splice(const_iterator position, const_iterator element) {
+				OiMap::splice(position, element);
+				_touch(element->first, true);
+			}
+			void splice(const_iterator position, const_iterator left, const_iterator right) {
+				for(const_iterator it = left; it != right; ++it)
+					_touch(it->first, true);
+				OiMap::splice(position, left, right);
+			}
+			void move_to_front(const_iterator element) {
+				OiMap::move_to_front(element);
+				_touch(element->first, true);
+			}
+
+			template<class Compare>
+			void sort_order(Compare comp, unsigned threads = 1) { // whole list reorders are sent as a reset, it's cheaper than a move per element
+				OiMap::sort_order(std::move(comp), threads);
+				_reset();
+			}
+			template<class Predicate>
+			iterator stable_partition_order(Predicate pred) {
+				iterator ret = OiMap::stable_partition_order(std::move(pred));
+				_reset();
+				return ret;
+			}
+			void reverse_order() {
+				OiMap::reverse_order();
+				_reset();
+			}
+
+			void pop_front() {
+				trim_front(1);
+			}
+			size_type trim_front(size_type n) {
+				return trim_front(n, [](value_type&) {});
+			}
+			template<class Fn>
+			size_type trim_front(size_type n, Fn&& on_evict) {
+				return OiMap::trim_front(n, [this, &on_evict](value_type& val) {
+					_touch(val.first, false);
+					on_evict(val);
+				});
+			}
+			size_type trim_front_before(seq_type seq) {
+				return trim_front_before(seq, [](value_type&) {});
+			}
+			template<class Fn>
+			size_type trim_front_before(seq_type seq, Fn&& on_evict) {
+				return OiMap::trim_front_before(seq, [this, &on_evict](value_type& val) {
+					_touch(val.first, false);
+					on_evict(val);
+				});
+			}
+
+			// Change Tracking:
+
+			epoch_type epoch() const noexcept {
+				return _epoch;
+			}
+			void forget(epoch_type epoch) { // drops the records only needed by changes_since() older epochs, those get a reset delta from now on
+				epoch = std::min(epoch, _epoch);
+				while(!_log.empty() && _log.front().second->epoch <= epoch) {
+					key_type key = *_log.front().first;
+					_log.pop_front();
+					_keys.erase(key);
+				}
+				_horizon = std::max(_horizon, epoch);
+			}
+
+			delta changes_since(epoch_type since) const { // every key touched after since once, with its current value, in O(touched keys)
+				delta ret;
+				ret.since = since;
+				ret.until = _epoch;
+				if(since < _horizon) {
+					ret.reset = true;
+					ret.values.reserve(this->size());
+					for(const value_type& val : *this)
+						ret.values.emplace_back(val.first, val.second);
+					return ret;
+				}
+				std::unordered_map<const value_type*, std::pair<size_type, bool>> index; // values index and whether it moved
+				std::vector<const_iterator> moved;
+				for(typename _log_t::const_reverse_iterator rec = _log.rbegin(); rec != _log.rend() && rec->second->epoch > since; ++rec) {
+					const_iterator it = this->find(*rec->first);
+					if(it == this->cend()) {
+						ret.erased.push_back(*rec->first);
+						continue;
+					}
+					index.emplace(&*it, std::make_pair(ret.values.size(), rec->second->moved > since));
+					ret.values.emplace_back(it->first, it->second);
+					if(rec->second->moved > since)
+						moved.push_back(it);
+				}
+				auto is_moved = [&index](const_iterator it) {
+					typename std::unordered_map<const value_type*, std::pair<size_type, bool>>::const_iterator found = index.find(&*it);
+					return found != index.end() && found->second.second;
+				};
+				for(const_iterator head : moved) { // each run of consecutive moved elements goes after the unmoved element before it
+					if(head != this->cbegin() && is_moved(std::prev(head)))
+						continue;
+					size_type anchor = index[&*head].first;
+					if(head != this->cbegin()) {
+						const_iterator prev = std::prev(head);
+						std::pair<typename std::unordered_map<const value_type*, std::pair<size_type, bool>>::iterator, bool> found = index.emplace(&*prev, std::make_pair(ret.values.size(), false));
+						if(found.second)
+							ret.values.emplace_back(prev->first, prev->second);
+						anchor = found.first->second.first;
+					}
+					for(const_iterator it = head; it != this->cend() && is_moved(it); ++it) {
+						size_type element = index[&*it].first;
+						ret.moves.emplace_back(element, anchor);
+						anchor = element;
+					}
+				}
+				return ret;
+			}
+			void apply_delta(const delta& d) { // the replica has to hold what the sender held at d.since, unless d.reset
+				if(d.reset)
+					clear();
+				for(const key_type& key : d.erased)
+					erase(key);
+				std::vector<iterator> placed;
+				placed.reserve(d.values.size());
+				for(const std::pair<key_type, mapped_type>& val : d.values) {
+					std::pair<iterator, bool> ret = insert(value_type(val.first, val.second));
+					if(!ret.second) {
+						_assign(ret.first, val.second, 0);
+						_touch(ret.first->first, false);
+					}
+					placed.push_back(ret.first);
+				}
+				for(const std::pair<size_type, size_type>& mv : d.moves)
+					splice(mv.first == mv.second ? this->cbegin() : std::next(const_iterator(placed[mv.second])), placed[mv.first]);
+			}
+
+		private:
+
+			struct _change {
+				epoch_type epoch = 0; // last time the key was touched
+				epoch_type moved = 0; // last time it was inserted or spliced
+				typename std::list<std::pair<const key_type*, const _change*>>::iterator pos; // its place in _log
+			};
+
+			using _record	= std::pair<const key_type*, const _change*>;
+			using _log_t	= std::list<_record>;
+			using _keys_t	= typename __oi_map_details::tracked_keys<OiMap, _change>::type;
+
+			_keys_t		_keys = __oi_map_details::tracked_keys<OiMap, _change>::make(*this);
+			_log_t		_log; // records sorted by epoch, the latest at the back
+			epoch_type	_epoch = 1;
+			epoch_type	_horizon = 1; // changes_since() anything older resets the replica
+
+			void _touch(const key_type& key, bool moved) {
+				typename _keys_t::iterator at = _keys.find(key);
+				if(at == _keys.end()) {
+					at = _keys.emplace(key, _change()).first;
+					_log.emplace_back(&at->first, &at->second);
+					at->second.pos = --_log.end();
+				}
+				else {
+					_log.splice(_log.end(), _log, at->second.pos);
+				}
+				at->second.epoch = ++_epoch;
+				if(moved)
+					at->second.moved = _epoch;
+			}
+			void _reset() {
+				_keys.clear();
+				_log.clear();
+				_horizon = ++_epoch;
+			}
+
+			template<class M = OiMap>
+			auto _assign(iterator pos, const mapped_type& val, int) -> decltype(std::declval<M&>().template get<0>(), void()) { // secondary indexes have to see the new value
+				OiMap::modify(pos, [&val](mapped_type& old) { old = val; });
+			}
+			void _assign(iterator pos, const mapped_type& val, long) {
+				pos->second = val;
+			}
+
+	};
+
+	template<class Key, class Value, std::size_t N, class Predicate = std::less<Key>, class Allocator = std::allocator<std::pair<const Key, Value>>>
+	class oi_small_map { // keeps up to N entries inline (no heap allocations), spills to an oi_map when it grows past N
+
+		static_assert(N > 0, "oi_small_map requires an inline capacity of at least 1");
+
+		private:
+
+			using _big_t	= oi_map<Key, Value, Predicate, Allocator>;
+			using _slot_t	= typename __oi_map_details::small_slot<N>::type;
+			using _link_t	= __oi_map_details::small_link<_slot_t>;
+
+			static constexpr bool _nothrow_move = std::is_nothrow_move_constructible<std::pair<const Key, Value>>::value && std::is_nothrow_copy_constructible<Predicate>::value && std::is_nothrow_copy_assignable<Predicate>::value && std::is_nothrow_copy_constructible<Allocator>::value; // the inline elements are moved one by one
+
+		public:
+
+			// Member Types:
+
+			using key_type					= Key;
+			using mapped_type				= Value;
+			using value_type				= std::pair<const key_type, mapped_type>;
+			using size_type					= std::size_t;
+			using difference_type			= std::ptrdiff_t;
+
+			using allocator_type			= Allocator;
+			using key_compare				= Predicate;
+
+			using reference					= value_type&;
+			using const_reference			= const value_type&;
+			using pointer					= value_type*;
+			using const_pointer				= const value_type*;
+
+			using iterator					= __oi_map_details::small_iter<value_type, _slot_t, typename _big_t::iterator>;
+			using const_iterator			= __oi_map_details::small_iter<const value_type, _slot_t, typename _big_t::const_iterator>;
+			using reverse_iterator			= std::reverse_iterator<iterator>;
+			using const_reverse_iterator	= std::reverse_iterator<const_iterator>;
+
+			using m_iterator				= __oi_map_details::small_m_iter<value_type, _slot_t, typename _big_t::m_iterator>;
+			using m_const_iterator			= __oi_map_details::small_m_iter<const value_type, _slot_t, typename _big_t::m_const_iterator>;
+			using m_reverse_iterator		= std::reverse_iterator<m_iterator>;
+			using m_const_reverse_iterator	= std::reverse_iterator<m_const_iterator>;
+
+			// Constructors:
+
+			oi_small_map() {
+				_reset();
+			}
+			explicit oi_small_map(const key_compare& comp, const allocator_type& alloc = allocator_type()) : _comp(comp), _alloc(alloc) {
+				_reset();
+			}
+			template<class InputIterator>
+			oi_small_map(InputIterator left, InputIterator right, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) : oi_small_map(comp, alloc) {
+				insert(left, right);
+			}
+			oi_small_map(std::initializer_list<value_type> il, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) : oi_small_map(comp, alloc) {
+				insert(il);
+			}
+
+			oi_small_map(const oi_small_map& other) : oi_small_map(other._comp, other._alloc) {
+				insert(other.begin(), other.end());
+			}
+			oi_small_map(oi_small_map&& other) noexcept(_nothrow_move) : oi_small_map(other._comp, other._alloc) {
+				_steal(other);
+			}
+
+			~oi_small_map() {
+				clear();
+			}
+
+			oi_small_map& operator=(const oi_small_map& other) {
+				if(this != &other) {
+					clear();
+					_comp = other._comp;
+					insert(other.begin(), other.end());
+				}
+				return *this;
+			}
+			oi_small_map& operator=(oi_small_map&& other) noexcept(_nothrow_move) {
+				if(this != &other) {
+					clear();
+					_comp = other._comp;
+					_steal(other);
+				}
+				return *this;
+			}
+			oi_small_map& operator=(std::initializer_list<value_type> il) {
+				insert(il);
+				return *this;
+			}
+
+			// Iterators:
+
+			iterator begin() noexcept {
+				return _big ? iterator(_big->begin()) : _at(_links[N].next);
+			}
+			const_iterator begin() const noexcept {
+				return _big ? const_iterator(_spilled_map().begin()) : _at(_links[N].next);
+			}
+			const_iterator cbegin() const noexcept {
+				return begin();
+			}
+			iterator end() noexcept {
+				return _big ? iterator(_big->end()) : _at(N);
+			}
+			const_iterator end() const noexcept {
+				return _big ? const_iterator(_spilled_map().end()) : _at(N);
+			}
+			const_iterator cend() const noexcept {
+				return end();
+			}
+
+			reverse_iterator rbegin() noexcept {
+				return reverse_iterator(end());
+			}
+			const_reverse_iterator rbegin() const noexcept {
+				return const_reverse_iterator(end());
+			}
+			const_reverse_iterator crbegin() const noexcept {
+				return rbegin();
+			}
+			reverse_iterator rend() noexcept {
+				return reverse_iterator(begin());
+			}
+			const_reverse_iterator rend() const noexcept {
+				return const_reverse_iterator(begin());
+			}
+			const_reverse_iterator crend() const noexcept {
+				return rend();
+			}
+
+			m_iterator m_begin() noexcept {
+				return _big ? m_iterator(_big->m_begin()) : m_iterator(_order, _data(), _links);
+			}
+			m_const_iterator m_begin() const noexcept {
+				return _big ? m_const_iterator(_spilled_map().m_begin()) : m_const_iterator(_order, _data(), _links);
+			}
+			m_const_iterator m_cbegin() const noexcept {
+				return m_begin();
+			}
+			m_iterator m_end() noexcept {
+				return _big ? m_iterator(_big->m_end()) : m_iterator(_order + _size, _data(), _links);
+			}
+			m_const_iterator m_end() const noexcept {
+				return _big ? m_const_iterator(_spilled_map().m_end()) : m_const_iterator(_order + _size, _data(), _links);
+			}
+			m_const_iterator m_cend() const noexcept {
+				return m_end();
+			}
+
+			m_reverse_iterator m_rbegin() noexcept {
+				return m_reverse_iterator(m_end());
+			}
+			m_const_reverse_iterator m_rbegin() const noexcept {
+				return m_const_reverse_iterator(m_end());
+			}
+			m_const_reverse_iterator m_crbegin() const noexcept {
+				return m_rbegin();
+			}
+			m_reverse_iterator m_rend() noexcept {
+				return m_reverse_iterator(m_begin());
+			}
+			m_const_reverse_iterator m_rend() const noexcept {
+				return m_const_reverse_iterator(m_begin());
+			}
+			m_const_reverse_iterator m_crend() const noexcept {
+				return m_rend();
+			}
+
+			// Capacity:
+
+			bool empty() const noexcept {
+				return size() == 0;
+			}
+			size_type size() const noexcept {
+				return _big ? _spilled_map().size() : _size;
+			}
+			size_type max_size() const noexcept {
+				return std::numeric_limits<size_type>::max() / sizeof(value_type);
+			}
+			bool spilled() const noexcept {
+				return _big != nullptr;
+			}
+
+			// Element Access:
+
+			mapped_type& operator[](const key_type& key) {
+				return (*insert(std::make_pair(key, mapped_type())).first).second;
+			}
+			mapped_type& operator[](key_type&& key) {
+				return (*insert(std::make_pair(std::forward<key_type>(key), mapped_type())).first).second;
+			}
+
+			mapped_type& at(const key_type& key) {
+				iterator it = find(key);
+				if(it == end())
+					throw std::out_of_range("oi_small_map::at");
+				return it->second;
+			}
+			const mapped_type& at(const key_type& key) const {
+				const_iterator it = find(key);
+				if(it == end())
+					throw std::out_of_range("oi_small_map::at");
+				return it->second;
+			}
+
+			// Modifiers:
+
+			std::pair<iterator, bool> insert(const value_type& val) {
+				return _insert(val);
+			}
+			template<typename P, typename = typename std::enable_if<std::is_constructible<value_type, P&&>::value>::type>
+			std::pair<iterator, bool> insert(P&& val) {
+				return _insert(std::forward<P>(val));
+			}
+			iterator insert(const_iterator hint, const value_type& val) {
+				return insert(val).first;
+			}
+			template<typename P, typename = typename std::enable_if<std::is_constructible<value_type, P&&>::value>::type>
+			iterator insert(const_iterator hint, P&& val) {
+				return insert(std::forward<P>(val)).first;
+			}
+			template<class InputIterator>
+			void insert(InputIterator left, InputIterator right) {
+				for(; left != right; ++left)
+					insert(*left);
+			}
+			void insert(std::initializer_list<value_type> init_list) {
+				insert(init_list.begin(), init_list.end());
+			}
+
+			iterator erase(const_iterator pos) {
+				if(_big)
+					return _big->erase(pos._big);
+				_slot_t at = pos._slot;
+				_slot_t next = _links[at].next;
+				_slot_t* slot = _lower(pos->first);
+				std::copy(slot + 1, _order + _size + 1, slot);
+				_unlink(at);
+				_data()[at].~value_type();
+				_links[at].next = _free;
+				_free = at;
+				--_size;
+				return _at(next);
+			}
+			size_type erase(const key_type& key) {
+				iterator it = find(key);
+				if(it == end())
+					return 0;
+				erase(it);
+				return 1;
+			}
+			iterator erase(const_iterator left, const_iterator right) {
+				if(_big)
+					return _big->erase(left._big, right._big);
+				while(left != right)
+					left = erase(left);
+				return _at(right._slot);
+			}
+
+			template<class... Args>
+			std::pair<iterator, bool> emplace(Args&&... args) {
+				return insert(std::pair<Args...>(std::forward<Args>(args)...));
+			}
+			template<class... Args>
+			iterator emplace_hint(const_iterator hint, Args&&... args) {
+				return insert(std::pair<Args...>(std::forward<Args>(args)...)).first;
+			}
+
+			void swap(oi_small_map& other) {
+				oi_small_map tmp(std::move(other));
+				other = std::move(*this);
+				*this = std::move(tmp);
+			}
+
+			void clear() noexcept {
+				value_type* data = _data();
+				for(_slot_t at = _links[N].next; at != N; at = _links[at].next)
+					data[at].~value_type();
+				_reset();
+				_big.reset();
+			}
+
+			// Operations:
+
+			iterator find(const key_type& key) {
+				if(_big)
+					return _big->find(key);
+				_slot_t* slot = _lower(key);
+				return _match(slot, key) ? _at(*slot) : end();
+			}
+			const_iterator find(const key_type& key) const {
+				if(_big)
+					return _spilled_map().find(key);
+				const _slot_t* slot = _lower(key);
+				return _match(slot, key) ? _at(*slot) : end();
+			}
+
+			size_type count(const key_type& key) const {
+				return find(key) != end() ? 1 : 0;
+			}
+
+			iterator lower_bound(const key_type& key) {
+				if(_big)
+					return _big->lower_bound(key);
+				_slot_t* slot = _lower(key);
+				return _at(*slot); // N once past the last slot
+			}
+			const_iterator lower_bound(const key_type& key) const {
+				if(_big)
+					return _spilled_map().lower_bound(key);
+				const _slot_t* slot = _lower(key);
+				return _at(*slot);
+			}
+			iterator upper_bound(const key_type& key) {
+				if(_big)
+					return _big->upper_bound(key);
+				_slot_t* slot = _upper(key);
+				return _at(*slot);
+			}
+			const_iterator upper_bound(const key_type& key) const {
+				if(_big)
+					return _spilled_map().upper_bound(key);
+				const _slot_t* slot = _upper(key);
+				return _at(*slot);
+			}
+
+			std::pair<iterator, iterator> equal_range(const key_type& key) {
+				return std::pair<iterator, iterator>(lower_bound(key), upper_bound(key));
+			}
+			std::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+				return std::pair<const_iterator, const_iterator>(lower_bound(key), upper_bound(key));
+			}
+
+			// Observers:
+
+			key_compare key_comp() const {
+				return _comp;
+			}
+
+			// Allocator:
+
+			allocator_type get_allocator() const noexcept {
+				return _alloc;
+			}
+
+			// Extra:
+
+			void splice(const_iterator position, const_iterator element) {
+				if(_big)
+					_big->splice(position._big, element._big);
+				else
+					_relink(position._slot, element._slot, _links[element._slot].next);
+			}
+			void splice(const_iterator position, const_iterator left, const_iterator right) {
+				if(_big)
+					_big->splice(position._big, left._big, right._big);
+				else
+					_relink(position._slot, left._slot, right._slot);
+			}
+
+		private:
+
+			alignas(value_type) unsigned char _storage[N * sizeof(value_type)]; // elements never move once constructed, so nothing is destroyed before its replacement exists
+			_link_t					_links[N + 1]; // insertion order, a circular list through the positions in _storage with N as its head, the free positions are chained through next
+			_slot_t					_order[N + 1]; // positions in _storage sorted by key, followed by N
+			_slot_t					_free; // first free position in _storage
+			size_type				_size;
+			std::unique_ptr<_big_t>	_big; // only allocated once the map spills
+			key_compare				_comp;
+			allocator_type			_alloc;
+
+			value_type* _data() noexcept {
+				return reinterpret_cast<value_type*>(_storage);
+			}
+			const value_type* _data() const noexcept {
+				return reinterpret_cast<const value_type*>(_storage);
+			}
+			const _big_t& _spilled_map() const noexcept {
+				return *_big;
+			}
+			iterator _at(_slot_t at) noexcept {
+				return iterator(_links, _data(), at);
+			}
+			const_iterator _at(_slot_t at) const noexcept {
+				return const_iterator(_links, _data(), at);
+			}
+
+			// N is small, so a binary search over the sorted slots beats hashing and also yields the insertion slot
+			_slot_t* _lower(const key_type& key) {
+				const value_type* data = _data();
+				return std::lower_bound(_order, _order + _size, key, [&](_slot_t slot, const key_type& k) { return _comp(data[slot].first, k); });
+			}
+			const _slot_t* _lower(const key_type& key) const {
+				const value_type* data = _data();
+				return std::lower_bound(_order, _order + _size, key, [&](_slot_t slot, const key_type& k) { return _comp(data[slot].first, k); });
+			}
+			_slot_t* _upper(const key_type& key) {
+				const value_type* data = _data();
+				return std::upper_bound(_order, _order + _size, key, [&](const key_type& k, _slot_t slot) { return _comp(k, data[slot].first); });
+			}
+			const _slot_t* _upper(const key_type& key) const {
+				const value_type* data = _data();
+				return std::upper_bound(_order, _order + _size, key, [&](const key_type& k, _slot_t slot) { return _comp(k, data[slot].first); });
+			}
+			bool _match(const _slot_t* slot, const key_type& key) const {
+				return slot != _order + _size && !_comp(key, _data()[*slot].first);
+			}
+
+			template<class P>
+			std::pair<iterator, bool> _insert(P&& val) {
+				if(_big)
+					return _big->insert(std::forward<P>(val));
+				_slot_t* slot = _lower(val.first);
+				if(_match(slot, val.first))
+					return std::pair<iterator, bool>(_at(*slot), false);
+				if(_size == N)
+					return _spill(std::forward<P>(val));
+				_slot_t at = _free;
+				::new(static_cast<void*>(_data() + at)) value_type(std::forward<P>(val));
+				_free = _links[at].next;
+				_link(at, N);
+				std::copy_backward(slot, _order + _size + 1, _order + _size + 2);
+				*slot = at;
+				++_size;
+				return std::pair<iterator, bool>(_at(at), true);
+			}
+
+			template<class P>
+			std::pair<iterator, bool> _spill(P&& val) { // the elements are only moved out when that can't throw, and moved back if the oi_map fails to take them or val
+				value_type* data = _data();
+				std::unique_ptr<_big_t> big(new _big_t(_comp, _alloc));
+				typename _big_t::iterator it;
+				try {
+					for(_slot_t at = _links[N].next; at != N; at = _links[at].next)
+						big->insert(std::move_if_noexcept(data[at]));
+					it = big->insert(std::forward<P>(val)).first;
+				}
+				catch(...) {
+					_unspill(*big, std::integral_constant<bool, std::is_nothrow_move_constructible<value_type>::value || !std::is_copy_constructible<value_type>::value>());
+					throw;
+				}
+				clear();
+				_big = std::move(big);
+				return std::pair<iterator, bool>(iterator(it), true);
+			}
+			void _unspill(_big_t& big, std::true_type) {
+				value_type* data = _data();
+				_slot_t at = _links[N].next;
+				for(value_type& val : big) {
+					if(at == N)
+						break; // the new element
+					data[at].~value_type();
+					::new(static_cast<void*>(data + at)) value_type(std::move(val));
+					at = _links[at].next;
+				}
+			}
+			void _unspill(_big_t&, std::false_type) noexcept {} // they were copied
+
+			void _steal(oi_small_map& other) { // the inline elements keep their positions
+				if(other._big) {
+					_big = std::move(other._big);
+					return;
+				}
+				value_type* data = _data();
+				value_type* other_data = other._data();
+				_slot_t at = other._links[N].next;
+				try {
+					for(; at != N; at = other._links[at].next)
+						::new(static_cast<void*>(data + at)) value_type(std::move_if_noexcept(other_data[at]));
+				}
+				catch(...) {
+					for(_slot_t built = other._links[N].next; built != at; built = other._links[built].next)
+						data[built].~value_type();
+					throw;
+				}
+				std::copy(other._links, other._links + N + 1, _links);
+				std::copy(other._order, other._order + N + 1, _order);
+				_free = other._free;
+				_size = other._size;
+				other.clear();
+			}
+
+			void _reset() noexcept { // every position free
+				for(std::size_t i = 0; i < N; ++i)
+					_links[i].next = static_cast<_slot_t>(i + 1);
+				_links[N].prev = _links[N].next = static_cast<_slot_t>(N);
+				_order[0] = static_cast<_slot_t>(N);
+				_free = 0;
+				_size = 0;
+			}
+			void _link(_slot_t at, _slot_t position) noexcept { // before position
+				_slot_t prev = _links[position].prev;
+				_links[at].prev = prev;
+				_links[at].next = position;
+				_links[prev].next = at;
+				_links[position].prev = at;
+			}
+			void _unlink(_slot_t at) noexcept {
+				_links[_links[at].prev].next = _links[at].next;
+				_links[_links[at].next].prev = _links[at].prev;
+			}
+			void _relink(_slot_t position, _slot_t left, _slot_t right) noexcept { // moves the inline elements [left, right) before position, like std::list::splice
+				if(left == right || position == left || position == right)
+					return;
+				_slot_t last = _links[right].prev;
+				_links[_links[left].prev].next = right;
+				_links[right].prev = _links[left].prev;
+				_slot_t prev = _links[position].prev;
+				_links[prev].next = left;
+				_links[left].prev = prev;
+				_links[last].next = position;
+				_links[position].prev = last;
+			}
+
+	};
+
+#ifdef __NEO_OI_MAP_CPP14__
+
+	template<class Key, class = void>
+	struct frozen_hash;
+
+	template<class Key>
+	struct frozen_hash<Key, typename std::enable_if<std::is_integral<Key>::value || std::is_enum<Key>::value>::type> {
+		constexpr std::uint64_t operator()(const Key& key, std::uint64_t seed) const { // splitmix64 finalizer
+			std::uint64_t h = static_cast<std::uint64_t>(key) + (seed + 1) * 0x9E3779B97F4A7C15ull;
+			h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ull;
+			h = (h ^ (h >> 27)) * 0x94D049BB133111EBull;
+			return h ^ (h >> 31);
+		}
+	};
+
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+	template<>
+	struct frozen_hash<std::string_view> {
+		constexpr std::uint64_t operator()(std::string_view key, std::uint64_t seed) const { // FNV-1a
+			std::uint64_t h = 0xCBF29CE484222325ull ^ (seed * 0x9E3779B97F4A7C15ull);
+			for(char c : key)
+				h = (h ^ static_cast<unsigned char>(c)) * 0x100000001B3ull;
+			return h ^ (h >> 32);
+		}
+	};
+#endif
+
+	template<class Key, class Value, std::size_t N, class Predicate = std::less<Key>, class Hash = frozen_hash<Key>>
+	class frozen_oi_map { // immutable oi_map built at compile time, find() goes through a perfect hash (hash and displace)
+
+		static_assert(N > 0, "frozen_oi_map requires at least 1 element");
+
+		private:
+
+			static constexpr std::size_t _bucket_count	= __oi_map_details::frozen_pow2(N);
+			static constexpr std::size_t _slot_count	= __oi_map_details::frozen_pow2(N) * 2;
+
+		public:
+
+			// Member Types:
+
+			using key_type					= Key;
+			using mapped_type				= Value;
+			using value_type				= std::pair<const key_type, mapped_type>;
+			using size_type					= std::size_t;
+			using difference_type			= std::ptrdiff_t;
+
+			using key_compare				= Predicate;
+			using hasher					= Hash;
+
+			using reference					= const value_type&;
+			using const_reference			= const value_type&;
+			using pointer					= const value_type*;
+			using const_pointer				= const value_type*;
+
+			using iterator					= const value_type*;
+			using const_iterator			= const value_type*;
+			using reverse_iterator			= std::reverse_iterator<const_iterator>;
+			using const_reverse_iterator	= std::reverse_iterator<const_iterator>;
+
+			using m_iterator				= __oi_map_details::frozen_m_iter<value_type>;
+			using m_const_iterator			= __oi_map_details::frozen_m_iter<value_type>;
+			using m_reverse_iterator		= std::reverse_iterator<m_const_iterator>;
+			using m_const_reverse_iterator	= std::reverse_iterator<m_const_iterator>;
+
+			// Constructors:
+
+			constexpr explicit frozen_oi_map(const std::pair<key_type, mapped_type> (&items)[N]) : frozen_oi_map(items, std::make_index_sequence<N>()) {}
+
+			// Iterators:
+
+			constexpr const_iterator begin() const noexcept {
+				return _items;
+			}
+			constexpr const_iterator cbegin() const noexcept {
+				return _items;
+			}
+			constexpr const_iterator end() const noexcept {
+				return _items + N;
+			}
+			constexpr const_iterator cend() const noexcept {
+				return _items + N;
+			}
+
+			const_reverse_iterator rbegin() const noexcept {
+				return const_reverse_iterator(end());
+			}
+			const_reverse_iterator crbegin() const noexcept {
+				return const_reverse_iterator(end());
+			}
+			const_reverse_iterator rend() const noexcept {
+				return const_reverse_iterator(begin());
+			}
+			const_reverse_iterator crend() const noexcept {
+				return const_reverse_iterator(begin());
+			}
+
+			constexpr m_const_iterator m_begin() const noexcept {
+				return m_const_iterator(_order, _items);
+			}
+			constexpr m_const_iterator m_cbegin() const noexcept {
+				return m_const_iterator(_order, _items);
+			}
+			constexpr m_const_iterator m_end() const noexcept {
+				return m_const_iterator(_order + N, _items);
+			}
+			constexpr m_const_iterator m_cend() const noexcept {
+				return m_const_iterator(_order + N, _items);
+			}
+
+			m_const_reverse_iterator m_rbegin() const noexcept {
+				return m_const_reverse_iterator(m_end());
+			}
+			m_const_reverse_iterator m_crbegin() const noexcept {
+				return m_const_reverse_iterator(m_end());
+			}
+			m_const_reverse_iterator m_rend() const noexcept {
+				return m_const_reverse_iterator(m_begin());
+			}
+			m_const_reverse_iterator m_crend() const noexcept {
+				return m_const_reverse_iterator(m_begin());
+			}
+
+			// Capacity:
+
+			constexpr bool empty() const noexcept {
+				return false;
+			}
+			constexpr size_type size() const noexcept {
+				return N;
+			}
+			constexpr size_type max_size() const noexcept {
+				return N;
+			}
+
+			// Element Access:
+
+			constexpr const mapped_type& at(const key_type& key) const {
+				return find(key) != end() ? find(key)->second : throw std::out_of_range("frozen_oi_map::at");
+			}
+
+			// Operations:
+
+			constexpr const_iterator find(const key_type& key) const {
+				std::int64_t seed = _seeds[_hash(key, 0) & (_bucket_count - 1)];
+				if(seed == 0)
+					return end();
+				std::size_t idx = _slots[seed < 0 ? static_cast<std::size_t>(-seed - 1) : _hash(key, static_cast<std::uint64_t>(seed)) & (_slot_count - 1)];
+				return idx != N && _equal(_items[idx].first, key) ? _items + idx : end();
+			}
+
+			constexpr size_type count(const key_type& key) const {
+				return find(key) != end() ? 1 : 0;
+			}
+
+			constexpr const_iterator lower_bound(const key_type& key) const {
+				const std::size_t* pos = _lower(key);
+				return pos != _order + N ? _items + *pos : end();
+			}
+			constexpr const_iterator upper_bound(const key_type& key) const {
+				const std::size_t* pos = _lower(key);
+				if(pos != _order + N && !_comp(key, _items[*pos].first))
+					++pos;
+				return pos != _order + N ? _items + *pos : end();
+			}
+
+			// Observers:
+
+			constexpr key_compare key_comp() const {
+				return _comp;
+			}
+			constexpr hasher hash_function() const {
+				return _hash;
+			}
+
+		private:
+
+			value_type		_items[N];					// declaration order
+			std::size_t		_order[N];					// positions in _items sorted by key
+			std::int64_t	_seeds[_bucket_count];		// 0: empty bucket, < 0: -(slot + 1) of its only key, > 0: seed of the second level hash
+			std::size_t		_slots[_slot_count];		// positions in _items, N if unused
+			key_compare		_comp;
+			hasher			_hash;
+
+			template<std::size_t... I>
+			constexpr frozen_oi_map(const std::pair<key_type, mapped_type> (&items)[N], std::index_sequence<I...>) : _items{ value_type(items[I].first, items[I].second)... }, _order{}, _seeds{}, _slots{}, _comp(), _hash() {
+				_sort_keys();
+				_build_table();
+			}
+
+			constexpr bool _equal(const key_type& left, const key_type& right) const {
+				return !_comp(left, right) && !_comp(right, left);
+			}
+
+			constexpr const std::size_t* _lower(const key_type& key) const {
+				std::size_t left = 0, right = N;
+				while(left < right) {
+					std::size_t mid = left + (right - left) / 2;
+					if(_comp(_items[_order[mid]].first, key))
+						left = mid + 1;
+					else
+						right = mid;
+				}
+				return _order + left;
+			}
+
+			constexpr void _sort_keys() { // heapsort, an O(N^2) sort runs out of constexpr steps on a few thousand unsorted keys
+				for(std::size_t i = 0; i < N; ++i)
+					_order[i] = i;
+				for(std::size_t i = N / 2; i > 0; --i)
+					_sift_down(i - 1, N);
+				for(std::size_t last = N; last > 1; --last) {
+					std::size_t top = _order[0];
+					_order[0] = _order[last - 1];
+					_order[last - 1] = top;
+					_sift_down(0, last - 1);
+				}
+				for(std::size_t i = 1; i < N; ++i) {
+					if(!_comp(_items[_order[i - 1]].first, _items[_order[i]].first))
+						throw std::invalid_argument("frozen_oi_map: duplicated key");
+				}
+			}
+			constexpr void _sift_down(std::size_t root, std::size_t length) {
+				for(std::size_t child = 2 * root + 1; child < length; root = child, child = 2 * root + 1) {
+					if(child + 1 < length && _comp(_items[_order[child]].first, _items[_order[child + 1]].first))
+						++child;
+					if(!_comp(_items[_order[root]].first, _items[_order[child]].first))
+						return;
+					std::size_t top = _order[root];
+					_order[root] = _order[child];
+					_order[child] = top;
+				}
+			}
+
+			constexpr void _build_table() {
+				std::size_t bucket_of[N] = {};
+				std::size_t start[_bucket_count + 1] = {};
+				std::size_t members[N] = {};
+				for(std::size_t i = 0; i < N; ++i) {
+					bucket_of[i] = _hash(_items[i].first, 0) & (_bucket_count - 1);
+					++start[bucket_of[i] + 1];
+				}
+				std::size_t largest = 0;
+				for(std::size_t b = 0; b < _bucket_count; ++b) {
+					largest = start[b + 1] > largest ? start[b + 1] : largest;
+					start[b + 1] += start[b];
+				}
+				std::size_t fill[_bucket_count] = {};
+				for(std::size_t i = 0; i < N; ++i)
+					members[start[bucket_of[i]] + fill[bucket_of[i]]++] = i;
+
+				for(std::size_t s = 0; s < _slot_count; ++s)
+					_slots[s] = N;
+				std::size_t taken[_slot_count] = {}; // id of the last attempt that claimed each slot, 0 if free
+				std::size_t attempt = 0;
+
+				for(std::size_t size = largest; size > 1; --size) { // the fullest buckets go first, while there is room to spare
+					for(std::size_t b = 0; b < _bucket_count; ++b) {
+						if(start[b + 1] - start[b] != size)
+							continue;
+						for(std::uint64_t seed = 1; ; ++seed) {
+							if(seed > (1u << 20))
+								throw std::invalid_argument("frozen_oi_map: no perfect hash found");
+							++attempt;
+							bool fits = true;
+							for(std::size_t m = start[b]; m < start[b + 1] && fits; ++m) {
+								std::size_t slot = _hash(_items[members[m]].first, seed) & (_slot_count - 1);
+								fits = _slots[slot] == N && taken[slot] != attempt;
+								taken[slot] = attempt;
+							}
+							if(fits) {
+								for(std::size_t m = start[b]; m < start[b + 1]; ++m)
+									_slots[_hash(_items[members[m]].first, seed) & (_slot_count - 1)] = members[m];
+								_seeds[b] = static_cast<std::int64_t>(seed);
+								break;
+							}
+						}
+					}
+				}
+
+				std::size_t free_slot = 0;
+				for(std::size_t b = 0; b < _bucket_count; ++b) { // lone keys take any free slot directly
+					if(start[b + 1] - start[b] != 1)
+						continue;
+					while(_slots[free_slot] != N)
+						++free_slot;
+					_slots[free_slot] = members[start[b]];
+					_seeds[b] = -static_cast<std::int64_t>(free_slot + 1);
+				}
+			}
+
+	};
+
+	template<class Key, class Value, class Predicate = std::less<Key>, class Hash = frozen_hash<Key>, std::size_t N>
+	constexpr frozen_oi_map<Key, Value, N, Predicate, Hash> make_frozen_oi_map(const std::pair<Key, Value> (&items)[N]) {
+		return frozen_oi_map<Key, Value, N, Predicate, Hash>(items);
+	}
+
+#endif
 
 }
 